@@ -0,0 +1,100 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/GTest/GTestConfig.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestConfigVersion.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets-release.cmake"
+  "/root/miniconda/lib/cmake/GTest/GTestTargets.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGTest.cmake"
+  "/usr/share/cmake-3.25/Modules/FindMPI.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GoogleTest.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/valgrind.dir/DependInfo.cmake"
+  "CMakeFiles/bench.dir/DependInfo.cmake"
+  "CMakeFiles/bench_p2p.dir/DependInfo.cmake"
+  "CMakeFiles/run_bench_p2p.dir/DependInfo.cmake"
+  "CMakeFiles/ut_aggregate.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_aggregate.dir/DependInfo.cmake"
+  "CMakeFiles/ut_channel.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_channel.dir/DependInfo.cmake"
+  "CMakeFiles/ut_collectives.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_collectives.dir/DependInfo.cmake"
+  "CMakeFiles/ut_dispatcher.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_dispatcher.dir/DependInfo.cmake"
+  "CMakeFiles/ut_exchange.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_exchange.dir/DependInfo.cmake"
+  "CMakeFiles/ut_file.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_file.dir/DependInfo.cmake"
+  "CMakeFiles/ut_large_count.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_large_count.dir/DependInfo.cmake"
+  "CMakeFiles/ut_packed.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_packed.dir/DependInfo.cmake"
+  "CMakeFiles/ut_progress.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_progress.dir/DependInfo.cmake"
+  "CMakeFiles/ut_ready.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_ready.dir/DependInfo.cmake"
+  "CMakeFiles/ut_request_set.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_request_set.dir/DependInfo.cmake"
+  "CMakeFiles/ut_shared_window.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_shared_window.dir/DependInfo.cmake"
+  "CMakeFiles/ut_simple_sendrecv.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_simple_sendrecv.dir/DependInfo.cmake"
+  "CMakeFiles/ut_stats.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_stats.dir/DependInfo.cmake"
+  "CMakeFiles/ut_topology.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_topology.dir/DependInfo.cmake"
+  "CMakeFiles/ut_types.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_types.dir/DependInfo.cmake"
+  "CMakeFiles/ut_window.dir/DependInfo.cmake"
+  "CMakeFiles/valgrind_window.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/run_bench_p2p"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/run_bench_p2p.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
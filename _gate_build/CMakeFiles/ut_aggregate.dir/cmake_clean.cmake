@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_aggregate.dir/test/aggregate.cc.o"
+  "CMakeFiles/ut_aggregate.dir/test/aggregate.cc.o.d"
+  "ut_aggregate"
+  "ut_aggregate.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_aggregate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_channel.dir/test/channel.cc.o"
+  "CMakeFiles/ut_channel.dir/test/channel.cc.o.d"
+  "ut_channel"
+  "ut_channel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_channel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_collectives.dir/test/collectives.cc.o"
+  "CMakeFiles/ut_collectives.dir/test/collectives.cc.o.d"
+  "ut_collectives"
+  "ut_collectives.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_collectives.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_dispatcher.dir/test/dispatcher.cc.o"
+  "CMakeFiles/ut_dispatcher.dir/test/dispatcher.cc.o.d"
+  "ut_dispatcher"
+  "ut_dispatcher.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_dispatcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
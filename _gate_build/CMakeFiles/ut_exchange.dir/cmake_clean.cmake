@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_exchange.dir/test/exchange.cc.o"
+  "CMakeFiles/ut_exchange.dir/test/exchange.cc.o.d"
+  "ut_exchange"
+  "ut_exchange.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_exchange.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
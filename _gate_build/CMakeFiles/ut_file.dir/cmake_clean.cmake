@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_file.dir/test/file.cc.o"
+  "CMakeFiles/ut_file.dir/test/file.cc.o.d"
+  "ut_file"
+  "ut_file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
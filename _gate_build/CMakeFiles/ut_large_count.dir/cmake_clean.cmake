@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_large_count.dir/test/large_count.cc.o"
+  "CMakeFiles/ut_large_count.dir/test/large_count.cc.o.d"
+  "ut_large_count"
+  "ut_large_count.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_large_count.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_packed.dir/test/packed.cc.o"
+  "CMakeFiles/ut_packed.dir/test/packed.cc.o.d"
+  "ut_packed"
+  "ut_packed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_packed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_progress.dir/test/progress.cc.o"
+  "CMakeFiles/ut_progress.dir/test/progress.cc.o.d"
+  "ut_progress"
+  "ut_progress.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_progress.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
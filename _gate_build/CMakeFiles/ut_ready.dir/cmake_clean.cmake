@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_ready.dir/test/ready.cc.o"
+  "CMakeFiles/ut_ready.dir/test/ready.cc.o.d"
+  "ut_ready"
+  "ut_ready.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_ready.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_request_set.dir/test/request_set.cc.o"
+  "CMakeFiles/ut_request_set.dir/test/request_set.cc.o.d"
+  "ut_request_set"
+  "ut_request_set.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_request_set.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
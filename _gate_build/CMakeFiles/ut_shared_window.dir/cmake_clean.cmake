@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_shared_window.dir/test/shared_window.cc.o"
+  "CMakeFiles/ut_shared_window.dir/test/shared_window.cc.o.d"
+  "ut_shared_window"
+  "ut_shared_window.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_shared_window.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
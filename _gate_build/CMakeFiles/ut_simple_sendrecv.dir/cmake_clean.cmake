@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_simple_sendrecv.dir/test/simple_sendrecv.cc.o"
+  "CMakeFiles/ut_simple_sendrecv.dir/test/simple_sendrecv.cc.o.d"
+  "ut_simple_sendrecv"
+  "ut_simple_sendrecv.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_simple_sendrecv.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_stats.dir/test/stats.cc.o"
+  "CMakeFiles/ut_stats.dir/test/stats.cc.o.d"
+  "ut_stats"
+  "ut_stats.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_stats.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
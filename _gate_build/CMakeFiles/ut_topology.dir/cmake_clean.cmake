@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_topology.dir/test/topology.cc.o"
+  "CMakeFiles/ut_topology.dir/test/topology.cc.o.d"
+  "ut_topology"
+  "ut_topology.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_topology.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_types.dir/test/types.cc.o"
+  "CMakeFiles/ut_types.dir/test/types.cc.o.d"
+  "ut_types"
+  "ut_types.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_types.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
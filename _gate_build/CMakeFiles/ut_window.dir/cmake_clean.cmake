@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut_window.dir/test/window.cc.o"
+  "CMakeFiles/ut_window.dir/test/window.cc.o.d"
+  "ut_window"
+  "ut_window.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut_window.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/valgrind_aggregate"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/valgrind_aggregate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/valgrind_dispatcher"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/valgrind_dispatcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/valgrind_exchange"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/valgrind_exchange.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,40 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ut_aggregate "ut_aggregate")
+set_tests_properties(ut_aggregate PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_channel "ut_channel")
+set_tests_properties(ut_channel PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_collectives "ut_collectives")
+set_tests_properties(ut_collectives PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_dispatcher "ut_dispatcher")
+set_tests_properties(ut_dispatcher PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_exchange "ut_exchange")
+set_tests_properties(ut_exchange PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_file "ut_file")
+set_tests_properties(ut_file PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_large_count "ut_large_count")
+set_tests_properties(ut_large_count PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_packed "ut_packed")
+set_tests_properties(ut_packed PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_progress "ut_progress")
+set_tests_properties(ut_progress PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_ready "ut_ready")
+set_tests_properties(ut_ready PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_request_set "ut_request_set")
+set_tests_properties(ut_request_set PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_shared_window "ut_shared_window")
+set_tests_properties(ut_shared_window PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_simple_sendrecv "ut_simple_sendrecv")
+set_tests_properties(ut_simple_sendrecv PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_stats "ut_stats")
+set_tests_properties(ut_stats PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_topology "ut_topology")
+set_tests_properties(ut_topology PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_types "ut_types")
+set_tests_properties(ut_types PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
+add_test(ut_window "ut_window")
+set_tests_properties(ut_window PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;90;add_test;/root/repo/CMakeLists.txt;147;add_unit_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,267 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+/**
+ * Micro-benchmarks comparing the overhead of the MPP point-to-point
+ * primitives (endpoint::send/isend/operator>>) against the equivalent raw
+ * MPI calls. Run with 2 ranks:
+ *
+ * 		mpirun -np 2 bench_p2p 		(or simply: make bench)
+ *
+ * Results are emitted on rank 0 as CSV lines:
+ *
+ * 		benchmark,impl,size_bytes,iterations,metric,value
+ */
+
+#include <mpp.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace mpi;
+
+namespace {
+
+const size_t min_size = 8;				// 8B
+const size_t max_size = 64*1024*1024;	// 64MB
+const int 	 window   = 64;				// in-flight msgs for bw/rate runs
+
+int iterations_for(size_t size) {
+	// keep the per-size runtime roughly constant
+	size_t iters = (64*1024*1024) / size;
+	if (iters > 10000) { iters = 10000; }
+	if (iters < 4)     { iters = 4; }
+	return static_cast<int>(iters);
+}
+
+void report(const char* bench, const char* impl, size_t size, int iters,
+			const char* metric, double value) {
+	if (comm::world.rank() == 0) {
+		std::printf("%s,%s,%zu,%d,%s,%f\n",
+					bench, impl, size, iters, metric, value);
+	}
+}
+
+// Ping-pong: round-trip a buffer between rank 0 and 1, reports the one-way
+// latency in microseconds
+void pingpong(size_t size, bool use_mpp) {
+	int iters = iterations_for(size);
+	std::vector<char> buf(size, 'x');
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	double start = MPI_Wtime();
+	for(int i=0; i<iters; ++i) {
+		if (comm::world.rank() == 0) {
+			if (use_mpp) {
+				comm::world(1) << buf;
+				comm::world(1) >> buf;
+			} else {
+				MPI_Send(&buf.front(), static_cast<int>(size), MPI_CHAR,
+						 1, 0, MPI_COMM_WORLD);
+				MPI_Status s;
+				MPI_Recv(&buf.front(), static_cast<int>(size), MPI_CHAR,
+						 1, 0, MPI_COMM_WORLD, &s);
+			}
+		} else {
+			if (use_mpp) {
+				comm::world(0) >> buf;
+				comm::world(0) << buf;
+			} else {
+				MPI_Status s;
+				MPI_Recv(&buf.front(), static_cast<int>(size), MPI_CHAR,
+						 0, 0, MPI_COMM_WORLD, &s);
+				MPI_Send(&buf.front(), static_cast<int>(size), MPI_CHAR,
+						 0, 0, MPI_COMM_WORLD);
+			}
+		}
+	}
+	double elapsed = MPI_Wtime() - start;
+	report("pingpong", use_mpp ? "mpp" : "mpi", size, iters,
+		   "latency_us", elapsed / (2.0*iters) * 1e6);
+}
+
+// Unidirectional bandwidth: rank 0 keeps `window` isends in flight towards
+// rank 1, reports MB/s
+void bandwidth_uni(size_t size, bool use_mpp) {
+	int iters = iterations_for(size);
+	std::vector<char> buf(size, 'x');
+	int ack = 0;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	double start = MPI_Wtime();
+	for(int i=0; i<iters; i+=window) {
+		int batch = i+window <= iters ? window : iters-i;
+		if (comm::world.rank() == 0) {
+			if (use_mpp) {
+				request_set set;
+				for(int k=0; k<batch; ++k) {
+					set.add( comm::world(1).isend( msg(buf) ) );
+				}
+				set.wait_all();
+				comm::world(1) >> ack;
+			} else {
+				std::vector<MPI_Request> reqs(batch);
+				for(int k=0; k<batch; ++k) {
+					MPI_Isend(&buf.front(), static_cast<int>(size), MPI_CHAR,
+							  1, 0, MPI_COMM_WORLD, &reqs[k]);
+				}
+				MPI_Waitall(batch, &reqs.front(), MPI_STATUSES_IGNORE);
+				MPI_Status s;
+				MPI_Recv(&ack, 1, MPI_INT, 1, 0, MPI_COMM_WORLD, &s);
+			}
+		} else {
+			if (use_mpp) {
+				request_set set;
+				for(int k=0; k<batch; ++k) {
+					set.add( comm::world(0) > msg(buf) );
+				}
+				set.wait_all();
+				comm::world(0) << ack;
+			} else {
+				std::vector<MPI_Request> reqs(batch);
+				for(int k=0; k<batch; ++k) {
+					MPI_Irecv(&buf.front(), static_cast<int>(size), MPI_CHAR,
+							  0, 0, MPI_COMM_WORLD, &reqs[k]);
+				}
+				MPI_Waitall(batch, &reqs.front(), MPI_STATUSES_IGNORE);
+				MPI_Send(&ack, 1, MPI_INT, 0, 0, MPI_COMM_WORLD);
+			}
+		}
+	}
+	double elapsed = MPI_Wtime() - start;
+	report("bandwidth_uni", use_mpp ? "mpp" : "mpi", size, iters,
+		   "MB_per_s", (static_cast<double>(size)*iters) / elapsed / 1e6);
+}
+
+// Bidirectional bandwidth: both ranks stream towards each other, reports
+// the aggregated MB/s
+void bandwidth_bi(size_t size, bool use_mpp) {
+	int iters = iterations_for(size);
+	std::vector<char> out(size, 'x');
+	std::vector<char> in(size);
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	double start = MPI_Wtime();
+	for(int i=0; i<iters; i+=window) {
+		int batch = i+window <= iters ? window : iters-i;
+		if (use_mpp) {
+			request_set set;
+			for(int k=0; k<batch; ++k) {
+				set.add( comm::world(other) > msg(in) );
+				set.add( comm::world(other).isend( msg(out) ) );
+			}
+			set.wait_all();
+		} else {
+			std::vector<MPI_Request> reqs(2*batch);
+			for(int k=0; k<batch; ++k) {
+				MPI_Irecv(&in.front(), static_cast<int>(size), MPI_CHAR,
+						  other, 0, MPI_COMM_WORLD, &reqs[2*k]);
+				MPI_Isend(&out.front(), static_cast<int>(size), MPI_CHAR,
+						  other, 0, MPI_COMM_WORLD, &reqs[2*k+1]);
+			}
+			MPI_Waitall(2*batch, &reqs.front(), MPI_STATUSES_IGNORE);
+		}
+	}
+	double elapsed = MPI_Wtime() - start;
+	report("bandwidth_bi", use_mpp ? "mpp" : "mpi", size, iters,
+		   "MB_per_s", 2.0*static_cast<double>(size)*iters / elapsed / 1e6);
+}
+
+// Message rate: 8B messages, reports msgs/s
+void message_rate(bool use_mpp) {
+	size_t size = min_size;
+	int iters = 100000;
+	std::vector<char> buf(size, 'x');
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	double start = MPI_Wtime();
+	for(int i=0; i<iters; i+=window) {
+		if (comm::world.rank() == 0) {
+			if (use_mpp) {
+				request_set set;
+				for(int k=0; k<window; ++k) {
+					set.add( comm::world(1).isend( msg(buf) ) );
+				}
+				set.wait_all();
+			} else {
+				std::vector<MPI_Request> reqs(window);
+				for(int k=0; k<window; ++k) {
+					MPI_Isend(&buf.front(), static_cast<int>(size), MPI_CHAR,
+							  1, 0, MPI_COMM_WORLD, &reqs[k]);
+				}
+				MPI_Waitall(window, &reqs.front(), MPI_STATUSES_IGNORE);
+			}
+		} else {
+			if (use_mpp) {
+				request_set set;
+				for(int k=0; k<window; ++k) {
+					set.add( comm::world(0) > msg(buf) );
+				}
+				set.wait_all();
+			} else {
+				std::vector<MPI_Request> reqs(window);
+				for(int k=0; k<window; ++k) {
+					MPI_Irecv(&buf.front(), static_cast<int>(size), MPI_CHAR,
+							  0, 0, MPI_COMM_WORLD, &reqs[k]);
+				}
+				MPI_Waitall(window, &reqs.front(), MPI_STATUSES_IGNORE);
+			}
+		}
+	}
+	double elapsed = MPI_Wtime() - start;
+	report("message_rate", use_mpp ? "mpp" : "mpi", size, iters,
+		   "msgs_per_s", static_cast<double>(iters) / elapsed);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv) {
+	mpi::init(argc, argv);
+
+	if (comm::world.size() != 2) {
+		if (comm::world.rank() == 0) {
+			std::fprintf(stderr, "bench_p2p requires exactly 2 ranks\n");
+		}
+		mpi::finalize();
+		return 1;
+	}
+
+	if (comm::world.rank() == 0) {
+		std::printf("benchmark,impl,size_bytes,iterations,metric,value\n");
+	}
+
+	for(size_t size = min_size; size <= max_size; size *= 8) {
+		pingpong(size, false);
+		pingpong(size, true);
+		bandwidth_uni(size, false);
+		bandwidth_uni(size, true);
+		bandwidth_bi(size, false);
+		bandwidth_bi(size, true);
+	}
+	message_rate(false);
+	message_rate(true);
+
+	mpi::finalize();
+	return 0;
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/endpoint.h"
+#include "detail/type_traits.h"
+
+#include <cstring>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// aggregator: opt-in coalescing layer for bursts of small messages towards
+// the same destination. Messages below the aggregation threshold are
+// copied into a per-destination staging buffer behind a compact framing
+// header (payload byte count) and shipped as a single wire message when
+// the buffer fills up, the tag changes, flush() is called or the
+// aggregator is destroyed. Messages above the threshold bypass the
+// staging buffer and are sent directly. The receive side splits the wire
+// message back into its frames via the disaggregator
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class aggregator {
+
+	typedef unsigned int frame_size_t;
+
+	endpoint 			m_dst;
+	std::vector<char> 	m_buf;
+	size_t 				m_capacity;
+	size_t 				m_threshold;
+	int 				m_tag;
+
+	// Make this class non-copyable
+	aggregator(const aggregator& other) = delete;
+	aggregator& operator=(const aggregator& other) = delete;
+
+public:
+	aggregator(endpoint&& dst, size_t capacity = 16*1024,
+			   size_t threshold = 512) :
+		m_dst(std::move(dst)),
+		m_capacity(capacity),
+		m_threshold(threshold),
+		m_tag(0)
+	{
+		m_buf.reserve(m_capacity);
+	}
+
+	aggregator(aggregator&& other) :
+		m_dst( std::move(other.m_dst) ),
+		m_buf( std::move(other.m_buf) ),
+		m_capacity( other.m_capacity ),
+		m_threshold( other.m_threshold ),
+		m_tag( other.m_tag ) { }
+
+	~aggregator() { flush(); }
+
+	// Stages a message (the payload of any contiguous mpi_type_traits
+	// type) for delivery; a message larger than the threshold is sent
+	// directly instead
+	template <class T>
+	inline aggregator& send(const T& v, int tag = 0) {
+		size_t bytes =
+			mpi_type_traits<const T>::get_size(v) *
+			sizeof(typename mpi_type_traits<T>::element_type);
+
+		if ( bytes > m_threshold ) {
+			// the direct payload shares source and tag with the wire
+			// frames: staged messages must leave first, or the receiver
+			// matches the payload ahead of them and misparses its bytes
+			// as framing headers
+			flush();
+			m_dst.send( msg_impl<const T>(v, tag) );
+			return *this;
+		}
+
+		// coalescing across tags would reorder matching: flush first
+		if ( tag != m_tag ) { flush(); m_tag = tag; }
+		if ( m_buf.size() + sizeof(frame_size_t) + bytes > m_capacity ) {
+			flush();
+			m_tag = tag;
+		}
+
+		frame_size_t len = static_cast<frame_size_t>(bytes);
+		size_t pos = m_buf.size();
+		m_buf.resize( pos + sizeof(frame_size_t) + bytes );
+		std::memcpy( &m_buf[pos], &len, sizeof(frame_size_t) );
+		std::memcpy( &m_buf[pos + sizeof(frame_size_t)],
+					 mpi_type_traits<const T>::get_addr(v), bytes );
+		return *this;
+	}
+
+	// Ships the staged frames as one wire message
+	inline aggregator& flush() {
+		if ( m_buf.empty() ) { return *this; }
+		m_dst.send( msg_impl<std::vector<char>>(m_buf, m_tag) );
+		m_buf.resize(0);
+		return *this;
+	}
+
+	inline size_t pending() const { return m_buf.size(); }
+
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// disaggregator: receives one aggregated wire message and splits it back
+// into its frames:
+//
+// 		disaggregator frames( comm::world(0) );
+// 		while( !frames.empty() ) { int v = frames.next<int>(); ... }
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class disaggregator {
+
+	typedef unsigned int frame_size_t;
+
+	std::vector<char> 	m_buf;
+	size_t 				m_pos;
+
+public:
+	disaggregator(endpoint&& src, int tag = 0) : m_pos(0) {
+		src.probe_recv(m_buf, tag);
+	}
+
+	inline bool empty() const { return m_pos >= m_buf.size(); }
+
+	// Byte size of the next frame
+	inline size_t next_size() const {
+		assert( !empty() && "No frame left" );
+		frame_size_t len;
+		std::memcpy( &len, &m_buf[m_pos], sizeof(frame_size_t) );
+		return len;
+	}
+
+	// Extracts the next frame into a value of the given type
+	template <class T>
+	inline T next() {
+		size_t bytes = next_size();
+		assert( bytes == sizeof(T) && "Frame size mismatch" );
+		T val;
+		std::memcpy( &val, &m_buf[m_pos + sizeof(frame_size_t)], bytes );
+		m_pos += sizeof(frame_size_t) + bytes;
+		return val;
+	}
+
+	// Extracts the next frame into a vector of the given element type
+	template <class T>
+	inline void next(std::vector<T>& vec) {
+		size_t bytes = next_size();
+		assert( bytes % sizeof(T) == 0 && "Frame size mismatch" );
+		vec.resize( bytes / sizeof(T) );
+		if ( bytes ) {
+			std::memcpy( &vec.front(),
+						 &m_buf[m_pos + sizeof(frame_size_t)], bytes );
+		}
+		m_pos += sizeof(frame_size_t) + bytes;
+	}
+
+};
+
+} // end mpi namespace
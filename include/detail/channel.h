@@ -0,0 +1,157 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/endpoint.h"
+#include "detail/status.h"
+
+#include <vector>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// channel: a persistent communication operation (MPI_Send_init/MPI_Recv_init)
+// between this process and an endpoint. The transfer (buffer, count, type,
+// tag and peer) is set up once at construction; each iteration then only
+// pays for MPI_Start/MPI_Wait, which lets the MPI library pre-match and pin
+// the buffer once for repeated same-buffer exchanges.
+//
+// Channels are created via endpoint::send_init() and endpoint::recv_init()
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class T>
+class channel {
+
+	const comm& 	m_comm;
+	msg_impl<T>		m_msg;
+	MPI_Datatype	m_type;
+	MPI_Request 	m_req;
+	MPI_Status		m_status;
+
+	channel(const comm& com, MPI_Request req, msg_impl<T>&& msg,
+			const MPI_Datatype& dt):
+		m_comm(com), m_msg(std::move(msg)), m_type(dt), m_req(req) { }
+
+	// Make this class non-copyable
+	channel(const channel<T>& other) = delete;
+	channel<T>& operator=(const channel<T>& other) = delete;
+
+	friend class endpoint;
+
+public:
+	channel(channel<T>&& other) :
+		m_comm( other.m_comm ),
+		m_msg( std::move(other.m_msg) ),
+		m_type( other.m_type ),
+		m_req( other.m_req ),
+		m_status( other.m_status )
+	{
+		other.m_req = MPI_REQUEST_NULL;
+	}
+
+	~channel() {
+		if (m_req != MPI_REQUEST_NULL) { MPI_Request_free(&m_req); }
+	}
+
+	// Activates the persistent transfer for one more iteration (MPI_Start)
+	inline channel<T>& start() {
+		int err = MPI_Start( &m_req );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to start persistent channel" );
+		}
+		return *this;
+	}
+
+	// Waits for the completion of the current iteration. The channel stays
+	// valid and can be started again
+	inline status wait() {
+		MPI_Wait( &m_req, &m_status );
+		return status(m_comm, m_status, m_type);
+	}
+
+	// Tests (without blocking) the completion of the current iteration
+	inline bool test() {
+		int flag;
+		MPI_Test( &m_req, &flag, &m_status );
+		return flag != 0;
+	}
+
+	inline const MPI_Request& mpi_request() const { return m_req; }
+
+};
+
+// Activates a whole set of channels in a single call (MPI_Startall)
+template <class T>
+inline void start_all(std::vector<channel<T>>& channels) {
+	std::vector<MPI_Request> reqs;
+	reqs.reserve( channels.size() );
+	for(auto& cur : channels) { reqs.push_back( cur.mpi_request() ); }
+	int err = MPI_Startall( static_cast<int>(reqs.size()), &reqs.front() );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err, "Failed to start " << channels.size()
+						  << " persistent channels" );
+	}
+}
+
+// Creates a persistent send channel towards this endpoint (MPI_Send_init)
+template <class MsgType>
+inline channel<MsgType> endpoint::send_init(msg_impl<MsgType>&& m) {
+	MPI_Datatype&& dt = m.type();
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Send_init( const_cast<void*>(static_cast<const void*>(m.addr())),
+						static_cast<int>(m.size()), dt,
+						m_rank,
+						m.tag(),
+						m_comm.mpi_comm(),
+						&req
+					  );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to create persistent send channel to rank '"
+			<< m_rank << "'" );
+	}
+	return channel<MsgType>(m_comm, req, std::move(m), dt);
+}
+
+// Creates a persistent receive channel from this endpoint (MPI_Recv_init)
+template <class MsgType>
+inline channel<MsgType> endpoint::recv_init(msg_impl<MsgType>&& m) {
+	MPI_Datatype&& dt = m.type();
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Recv_init( static_cast<void*>(m.addr()),
+						static_cast<int>(m.size()), dt,
+						m_rank,
+						m.tag(),
+						m_comm.mpi_comm(),
+						&req
+					  );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to create persistent recv channel from rank '"
+			<< m_rank << "'" );
+	}
+	return channel<MsgType>(m_comm, req, std::move(m), dt);
+}
+
+} // end mpi namespace
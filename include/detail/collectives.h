@@ -0,0 +1,192 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * Implementation of the collective operations declared in the comm class.
+ * Counts and datatypes are derived via mpi_type_traits (through msg_impl)
+ * exactly as the point-to-point paths do, so no manual re-derivation and no
+ * serialize-to-buffer detour is needed on the user side.
+ */
+
+#include "detail/decls.h"
+
+#include "detail/comm.h"
+#include "detail/message.h"
+#include "detail/request.h"
+
+#define MPP_CHECK_COLLECTIVE(Call, OpName) \
+	{ \
+		int _mpp_err = (Call); \
+		if( _mpp_err != MPI_SUCCESS ) { \
+			MPP_REPORT_ERROR( _mpp_err, "Failed to perform '" << OpName \
+							  << "' collective operation" ); \
+		} \
+	}
+
+namespace mpi {
+
+template <class MsgType>
+inline comm& comm::bcast(msg_impl<MsgType>&& m, int root) {
+	check_init();
+	MPP_CHECK_COLLECTIVE(
+		MPI_Bcast( const_cast<void*>(static_cast<const void*>(m.addr())),
+				   static_cast<int>(m.size()), m.type(),
+				   root, m_comm ),
+		"bcast" );
+	return *this;
+}
+
+template <class SndType, class RcvType>
+inline comm& comm::reduce(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+						  MPI_Op op, int root) {
+	check_init();
+	MPP_CHECK_COLLECTIVE(
+		MPI_Reduce( static_cast<const void*>(snd.addr()),
+					const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					static_cast<int>(snd.size()), snd.type(),
+					op, root, m_comm ),
+		"reduce" );
+	return *this;
+}
+
+template <class SndType, class RcvType>
+inline comm& comm::allreduce(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+							 MPI_Op op) {
+	check_init();
+	MPP_CHECK_COLLECTIVE(
+		MPI_Allreduce( static_cast<const void*>(snd.addr()),
+					   const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					   static_cast<int>(snd.size()), snd.type(),
+					   op, m_comm ),
+		"allreduce" );
+	return *this;
+}
+
+// The amount of data received by each rank (hence sent to each rank by the
+// root) is derived from the receive message
+template <class SndType, class RcvType>
+inline comm& comm::scatter(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+						   int root) {
+	check_init();
+	MPP_CHECK_COLLECTIVE(
+		MPI_Scatter( static_cast<const void*>(snd.addr()),
+					 static_cast<int>(rcv.size()), snd.type(),
+					 const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					 static_cast<int>(rcv.size()), rcv.type(),
+					 root, m_comm ),
+		"scatter" );
+	return *this;
+}
+
+// The amount of data collected from each rank is derived from the send
+// message
+template <class SndType, class RcvType>
+inline comm& comm::gather(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+						  int root) {
+	check_init();
+	MPP_CHECK_COLLECTIVE(
+		MPI_Gather( static_cast<const void*>(snd.addr()),
+					static_cast<int>(snd.size()), snd.type(),
+					const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					static_cast<int>(snd.size()), rcv.type(),
+					root, m_comm ),
+		"gather" );
+	return *this;
+}
+
+template <class MsgType>
+inline request<MsgType> comm::ibcast(msg_impl<MsgType>&& m, int root) {
+	check_init();
+	MPI_Request req;
+	MPI_Datatype&& dt = m.type();
+	MPP_CHECK_COLLECTIVE(
+		MPI_Ibcast( const_cast<void*>(static_cast<const void*>(m.addr())),
+					static_cast<int>(m.size()), dt,
+					root, m_comm, &req ),
+		"ibcast" );
+	return request<MsgType>(*this, req, std::move(m));
+}
+
+template <class SndType, class RcvType>
+inline request<RcvType> comm::ireduce(msg_impl<SndType>&& snd,
+									  msg_impl<RcvType>&& rcv, MPI_Op op,
+									  int root) {
+	check_init();
+	MPI_Request req;
+	MPP_CHECK_COLLECTIVE(
+		MPI_Ireduce( static_cast<const void*>(snd.addr()),
+					 const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					 static_cast<int>(snd.size()), snd.type(),
+					 op, root, m_comm, &req ),
+		"ireduce" );
+	return request<RcvType>(*this, req, std::move(rcv));
+}
+
+template <class SndType, class RcvType>
+inline request<RcvType> comm::iallreduce(msg_impl<SndType>&& snd,
+										 msg_impl<RcvType>&& rcv, MPI_Op op) {
+	check_init();
+	MPI_Request req;
+	MPP_CHECK_COLLECTIVE(
+		MPI_Iallreduce( static_cast<const void*>(snd.addr()),
+						const_cast<void*>(static_cast<const void*>(rcv.addr())),
+						static_cast<int>(snd.size()), snd.type(),
+						op, m_comm, &req ),
+		"iallreduce" );
+	return request<RcvType>(*this, req, std::move(rcv));
+}
+
+template <class SndType, class RcvType>
+inline request<RcvType> comm::iscatter(msg_impl<SndType>&& snd,
+									   msg_impl<RcvType>&& rcv, int root) {
+	check_init();
+	MPI_Request req;
+	MPP_CHECK_COLLECTIVE(
+		MPI_Iscatter( static_cast<const void*>(snd.addr()),
+					  static_cast<int>(rcv.size()), snd.type(),
+					  const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					  static_cast<int>(rcv.size()), rcv.type(),
+					  root, m_comm, &req ),
+		"iscatter" );
+	return request<RcvType>(*this, req, std::move(rcv));
+}
+
+template <class SndType, class RcvType>
+inline request<RcvType> comm::igather(msg_impl<SndType>&& snd,
+									  msg_impl<RcvType>&& rcv, int root) {
+	check_init();
+	MPI_Request req;
+	MPP_CHECK_COLLECTIVE(
+		MPI_Igather( static_cast<const void*>(snd.addr()),
+					 static_cast<int>(snd.size()), snd.type(),
+					 const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					 static_cast<int>(snd.size()), rcv.type(),
+					 root, m_comm, &req ),
+		"igather" );
+	return request<RcvType>(*this, req, std::move(rcv));
+}
+
+} // end mpi namespace
+
+#undef MPP_CHECK_COLLECTIVE
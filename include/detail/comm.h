@@ -20,9 +20,13 @@
  *
  ******************************************************************************/
 
-#pragma once 
+#pragma once
 
 #include "detail/decls.h"
+#include "detail/error.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace mpi {
 
@@ -32,42 +36,153 @@ namespace mpi {
 class comm {
 
 	MPI_Comm m_comm;
-	bool 	 m_initialized;
-	int 	 m_comm_size;
-	int 	 m_rank;
-
-	comm(MPI_Comm comm): 
-		m_comm(comm), 
-		m_initialized(false), 
-		m_comm_size(-1), 
+	bool 	 m_owned;		// whether the MPI_Comm handle belongs to this
+							// object (true for dup/split/topology comms)
+
+	// rank/size snapshot, immutable once the flag is published: after a
+	// successful acquire load of m_initialized, rank() and size() are
+	// plain loads callable from any thread
+	std::atomic<bool> 	m_initialized;
+	int 	 			m_comm_size;
+	int 	 			m_rank;
+
+	// Make this class non-copyable (two comm objects would otherwise fight
+	// over the ownership of the same MPI_Comm handle)
+	comm(const comm& other) = delete;
+	comm& operator=(const comm& other) = delete;
+
+	// Posts a single batch descriptor into the given set (see post.h)
+	template <class MsgType>
+	inline void post_one(request_set& set, isend_op<MsgType>&& op);
+
+	template <class MsgType>
+	inline void post_one(request_set& set, irecv_op<MsgType>&& op);
+
+protected:
+	comm(MPI_Comm comm, bool owned = false):
+		m_comm(comm),
+		m_owned(owned),
+		m_initialized(false),
+		m_comm_size(-1),
 		m_rank(-1) { }
 
-	// Check whether MPI_Init has been called
+	// Check whether MPI_Init has been called, snapshotting rank/size on
+	// the first invocation. The lazy path exists because comm::world is
+	// constructed before MPI_Init; mpi::init() attaches world eagerly, so
+	// under normal usage this is never entered after startup
 	inline void check_init() {
+		if (m_initialized.load(std::memory_order_acquire)) { return; }
+		attach();
+	}
+
+	// Storage for the lazily created node-local communicator handle (see
+	// node()); kept out of a plain static comm so that mpi::finalize() can
+	// release it before MPI shuts down
+	static inline MPI_Comm& node_comm_handle() {
+		static MPI_Comm handle = MPI_COMM_NULL;
+		return handle;
+	}
+
+public:
+	// MPI_COMM_WORLD
+	static comm world;
+
+	// The communicator grouping the ranks which share this node's memory
+	// (MPI_Comm_split_type with MPI_COMM_TYPE_SHARED), created on first
+	// use. Released by mpi::finalize()
+	static inline comm& node() {
+		MPI_Comm& handle = node_comm_handle();
+		if ( handle == MPI_COMM_NULL ) {
+			int err = MPI_Comm_split_type( MPI_COMM_WORLD,
+					MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &handle );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to create the node-local communicator" );
+			}
+		}
+		// a non-owning view: the handle is freed by free_node(), not by
+		// the comm destructor (which would run after MPI_Finalize)
+		static comm node_comm = comm(handle);
+		return node_comm;
+	}
+
+	// Frees the node-local communicator (if ever created); invoked by
+	// mpi::finalize()
+	static inline void free_node() {
+		MPI_Comm& handle = node_comm_handle();
+		if ( handle != MPI_COMM_NULL ) { MPI_Comm_free(&handle); }
+	}
+
+	comm(comm&& other) :
+		m_comm(other.m_comm),
+		m_owned(other.m_owned),
+		m_initialized(other.m_initialized.load()),
+		m_comm_size(other.m_comm_size),
+		m_rank(other.m_rank)
+	{
+		other.m_owned = false;
+	}
 
-		if (m_initialized) { return; }
+	// Snapshots rank and size into immutable members, exactly once: a
+	// shared lock serializes concurrent first calls so the snapshot is
+	// never torn. Invoked eagerly for comm::world by mpi::init() and
+	// lazily (through check_init) everywhere else
+	void attach() {
+		static std::mutex mtx;	// contended only while attaching, which
+								// happens once per communicator
+		std::lock_guard<std::mutex> lock(mtx);
+		if (m_initialized.load(std::memory_order_relaxed)) { return; }
 
 		int flag;
 		MPI_Initialized(&flag);
-		assert(flag != 0 && 
+		assert(flag != 0 &&
 			"FATAL: MPI environment not initialized (MPI_Init not called)");
 
-		m_initialized = true;
 		MPI_Comm_size(m_comm, &m_comm_size);
 		MPI_Comm_rank(m_comm, &m_rank);
+		m_initialized.store(true, std::memory_order_release);
 	}
 
-public:
-	// MPI_COMM_WORLD
-	static comm world;
+	// Owned communicators (created by dup/split/topologies) are released
+	// here: they must therefore be destroyed before mpi::finalize()
+	~comm() {
+		if (m_owned && m_comm != MPI_COMM_NULL) { MPI_Comm_free(&m_comm); }
+	}
+
+	// Duplicates this communicator (MPI_Comm_dup), providing a separate
+	// tag space for independent solver phases
+	inline comm dup() {
+		check_init();
+		MPI_Comm newcomm = MPI_COMM_NULL;
+		int err = MPI_Comm_dup( m_comm, &newcomm );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to duplicate communicator" );
+		}
+		return comm(newcomm, true);
+	}
+
+	// Partitions this communicator into disjoint sub-communicators, one
+	// per color (MPI_Comm_split)
+	inline comm split(int color, int key = 0) {
+		check_init();
+		MPI_Comm newcomm = MPI_COMM_NULL;
+		int err = MPI_Comm_split( m_comm, color, key, &newcomm );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to split communicator" );
+		}
+		return comm(newcomm, true);
+	}
 
+	// Once attached, a single load of an immutable member (the flag check
+	// compiles down to one well-predicted read): cheap enough to call in
+	// inner loops and from any thread
 	inline int rank() {
 		check_init();
 		return m_rank;
 	}
 
 	inline int rank() const {
-		assert(m_initialized && "MPI communicator not initialized");
+		assert(m_initialized.load() && "MPI communicator not initialized");
 		return m_rank;
 	}
 
@@ -77,7 +192,7 @@ public:
 	}
 
 	inline int size() const {
-		assert(m_initialized && "MPI communicator not initialized");
+		assert(m_initialized.load() && "MPI communicator not initialized");
 		return m_comm_size;
 	}
 
@@ -85,7 +200,134 @@ public:
 		return m_comm;
 	}
 
-	inline endpoint operator()( const int& rank_id ) const; 
+	inline endpoint operator()( const int& rank_id ) const;
+
+	// Posts a whole batch of nonblocking operations (descriptors built by
+	// isend_to/irecv_from, see post.h) after a single validation, the
+	// handles landing in one contiguous request_set ready for wait_all()
+	template <class... Ops>
+	inline request_set post(Ops&&... ops);
+
+	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	// Collective operations (see collectives.h). Element counts and MPI
+	// datatypes are derived from mpi_type_traits exactly as the p2p paths
+	// do. Message objects are accepted as rvalues (msg(..) temporaries),
+	// the raw overloads wrap plain containers/scalars on the fly
+	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	template <class MsgType>
+	inline comm& bcast(msg_impl<MsgType>&& m, int root);
+
+	template <class RawType>
+	inline comm& bcast(RawType& m, int root) {
+		return bcast( msg_impl<RawType>(m), root );
+	}
+
+	template <class SndType, class RcvType>
+	inline comm& reduce(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+						MPI_Op op, int root);
+
+	template <class SndRaw, class RcvRaw>
+	inline comm& reduce(const SndRaw& snd, RcvRaw& rcv, MPI_Op op, int root) {
+		return reduce( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+					   op, root );
+	}
+
+	template <class SndType, class RcvType>
+	inline comm& allreduce(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+						   MPI_Op op);
+
+	template <class SndRaw, class RcvRaw>
+	inline comm& allreduce(const SndRaw& snd, RcvRaw& rcv, MPI_Op op) {
+		return allreduce( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+						  op );
+	}
+
+	// Functor-based reductions (see op.h): recognized function objects
+	// (std::plus, mpi::maximum, ...) map at compile time onto the built-in
+	// MPI_Op constants, preserving hardware-offloaded reductions; any
+	// other commutative functor is registered once via MPI_Op_create and
+	// cached
+	template <class SndRaw, class RcvRaw, class Op>
+	inline comm& reduce(const SndRaw& snd, RcvRaw& rcv, Op op, int root);
+
+	template <class SndRaw, class RcvRaw, class Op>
+	inline comm& allreduce(const SndRaw& snd, RcvRaw& rcv, Op op);
+
+	template <class SndType, class RcvType>
+	inline comm& scatter(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+						 int root);
+
+	template <class SndRaw, class RcvRaw>
+	inline comm& scatter(const SndRaw& snd, RcvRaw& rcv, int root) {
+		return scatter( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+						root );
+	}
+
+	template <class SndType, class RcvType>
+	inline comm& gather(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv,
+						int root);
+
+	template <class SndRaw, class RcvRaw>
+	inline comm& gather(const SndRaw& snd, RcvRaw& rcv, int root) {
+		return gather( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+					   root );
+	}
+
+	// Nonblocking variants: the returned request<T> wraps the message being
+	// produced by the collective and composes with the completion API
+	// (request_set)
+
+	template <class MsgType>
+	inline request<MsgType> ibcast(msg_impl<MsgType>&& m, int root);
+
+	template <class RawType>
+	inline request<RawType> ibcast(RawType& m, int root) {
+		return ibcast( msg_impl<RawType>(m), root );
+	}
+
+	template <class SndType, class RcvType>
+	inline request<RcvType> iallreduce(msg_impl<SndType>&& snd,
+									   msg_impl<RcvType>&& rcv, MPI_Op op);
+
+	template <class SndRaw, class RcvRaw>
+	inline request<RcvRaw> iallreduce(const SndRaw& snd, RcvRaw& rcv,
+									  MPI_Op op) {
+		return iallreduce( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+						   op );
+	}
+
+	template <class SndType, class RcvType>
+	inline request<RcvType> ireduce(msg_impl<SndType>&& snd,
+									msg_impl<RcvType>&& rcv, MPI_Op op,
+									int root);
+
+	template <class SndRaw, class RcvRaw>
+	inline request<RcvRaw> ireduce(const SndRaw& snd, RcvRaw& rcv, MPI_Op op,
+								   int root) {
+		return ireduce( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+						op, root );
+	}
+
+	template <class SndType, class RcvType>
+	inline request<RcvType> iscatter(msg_impl<SndType>&& snd,
+									 msg_impl<RcvType>&& rcv, int root);
+
+	template <class SndRaw, class RcvRaw>
+	inline request<RcvRaw> iscatter(const SndRaw& snd, RcvRaw& rcv, int root) {
+		return iscatter( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+						 root );
+	}
+
+	template <class SndType, class RcvType>
+	inline request<RcvType> igather(msg_impl<SndType>&& snd,
+									msg_impl<RcvType>&& rcv, int root);
+
+	template <class SndRaw, class RcvRaw>
+	inline request<RcvRaw> igather(const SndRaw& snd, RcvRaw& rcv, int root) {
+		return igather( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv),
+						root );
+	}
 
 };
 
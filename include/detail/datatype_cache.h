@@ -0,0 +1,136 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <mpi.h>
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// datatype_cache: registry of committed MPI_Datatype handles keyed on the
+// memory layout of the message (displacements, block lengths and element
+// types as passed to MPI_Type_create_struct). Containers whose layout does
+// not change between sends (e.g. a std::list re-sent every iteration) hit
+// the cache and reuse the committed handle instead of rebuilding it. All
+// cached handles are freed by mpi::finalize().
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class datatype_cache {
+
+public:
+	// The layout signature of a non-contiguous message, i.e. the arguments
+	// which would be passed to MPI_Type_create_struct to build its datatype
+	struct layout {
+		std::vector<int> 			dimensions;
+		std::vector<MPI_Aint> 		displacements;
+		std::vector<MPI_Datatype> 	types;
+
+		layout(size_t size) :
+			dimensions(size), displacements(size), types(size) { }
+
+		layout(layout&& other) :
+			dimensions( std::move(other.dimensions) ),
+			displacements( std::move(other.displacements) ),
+			types( std::move(other.types) ) { }
+
+		bool operator==(const layout& other) const {
+			return dimensions == other.dimensions &&
+				   displacements == other.displacements &&
+				   types == other.types;
+		}
+	};
+
+private:
+	struct layout_hash {
+		size_t operator()(const layout& l) const {
+			size_t seed = l.dimensions.size();
+			for(size_t idx = 0; idx < l.dimensions.size(); ++idx) {
+				combine(seed, std::hash<int>()( l.dimensions[idx] ));
+				combine(seed, std::hash<MPI_Aint>()( l.displacements[idx] ));
+				combine(seed, std::hash<MPI_Datatype>()( l.types[idx] ));
+			}
+			return seed;
+		}
+
+		static inline void combine(size_t& seed, size_t val) {
+			seed ^= val + 0x9e3779b9 + (seed<<6) + (seed>>2);
+		}
+	};
+
+	std::unordered_map<layout, MPI_Datatype, layout_hash> m_cache;
+	std::vector<MPI_Datatype> m_adopted;
+
+	datatype_cache() { }
+
+	// Make this class non-copyable
+	datatype_cache(const datatype_cache& other) = delete;
+	datatype_cache& operator=(const datatype_cache& other) = delete;
+
+public:
+
+	static datatype_cache& instance() {
+		static datatype_cache cache;
+		return cache;
+	}
+
+	// Retrieves the committed datatype for the given layout. On the first
+	// encounter the datatype is built, committed and memoized so that
+	// structurally identical messages turn the O(n) type construction into
+	// a hash lookup
+	MPI_Datatype lookup(layout&& l) {
+		auto fit = m_cache.find(l);
+		if (fit != m_cache.end()) { return fit->second; }
+
+		MPI_Datatype dt;
+		MPI_Type_create_struct( static_cast<int>(l.dimensions.size()),
+								&l.dimensions.front(),
+								&l.displacements.front(),
+								&l.types.front(),
+								&dt );
+		MPI_Type_commit( &dt );
+
+		m_cache.emplace( std::move(l), dt );
+		return dt;
+	}
+
+	// Registers an externally built committed handle (e.g. a registered
+	// user type) to be freed together with the cached ones
+	void adopt(const MPI_Datatype& dt) {
+		m_adopted.push_back( dt );
+	}
+
+	// Frees all the committed handles (invoked by mpi::finalize() before
+	// MPI_Finalize is called)
+	void clear() {
+		for(auto& cur : m_cache) { MPI_Type_free( &cur.second ); }
+		m_cache.clear();
+		for(auto& cur : m_adopted) { MPI_Type_free( &cur ); }
+		m_adopted.clear();
+	}
+
+};
+
+} // end mpi namespace
@@ -25,6 +25,9 @@
 #include <mpi.h>
 
 #include <stdexcept>
+#include <sstream>
+#include <cassert>
+#include <vector>
 
 /** 
  * Contains the forward declaration of the base classes utilized by MPP
@@ -42,6 +45,25 @@ class request;
 
 class endpoint;
 
+class request_set;
+
+template <class T>
+struct isend_op;
+
+template <class T>
+struct irecv_op;
+
+class progress_engine;
+
+template <class T>
+class channel;
+
+template <class T>
+class ready_sender;
+
+template <class T>
+class ready_receiver;
+
 // Expection which is thrown every time a communication fails
 struct comm_error : public std::logic_error {
 
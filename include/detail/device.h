@@ -0,0 +1,106 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/type_traits.h"
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// device_span<T>: a non-owning view over 'count' elements living in
+// device memory, for use with a CUDA-aware MPI library. Its traits hand
+// the device pointer straight to the send/recv paths, so transfers go
+// GPUDirect with no host staging copy:
+//
+// 		device_span<double> halo( d_ptr, n );	// d_ptr from cudaMalloc
+// 		comm::world(right) << halo;				// no cudaMemcpy hop
+//
+// The wrapper itself is plain C++ (a pointer and a length) and never
+// dereferences the pointer, hence compiles without the CUDA toolkit;
+// whether the MPI library accepts device addresses is a property of the
+// MPI build, not of this header
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class T>
+class device_span {
+
+	T* 		m_ptr;
+	size_t 	m_count;
+
+public:
+	device_span() : m_ptr(NULL), m_count(0) { }
+
+	device_span(T* ptr, size_t count) : m_ptr(ptr), m_count(count) { }
+
+	inline T* data() const { return m_ptr; }
+	inline size_t size() const { return m_count; }
+
+};
+
+template <class T>
+struct mpi_type_traits<device_span<T>> {
+
+	typedef T element_type;
+	typedef T* element_addr_type;
+
+	static inline size_t get_size(device_span<T>& span) { return span.size(); }
+
+	static inline MPI_Datatype get_type(device_span<T>&& span) {
+		return mpi_type_traits<T>::get_type( T() );
+	}
+
+	static inline element_addr_type get_addr(device_span<T>& span) {
+		return span.data();
+	}
+
+};
+
+#if defined(THRUST_VERSION)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//	thrust::device_vector<T> traits, available when the thrust headers are
+//	included ahead of mpp.h; the raw device pointer feeds the transfer
+//	directly, exactly like device_span
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class T>
+struct mpi_type_traits<thrust::device_vector<T>> {
+
+	typedef T element_type;
+	typedef T* element_addr_type;
+
+	static inline size_t get_size(thrust::device_vector<T>& vec) {
+		return vec.size();
+	}
+
+	static inline MPI_Datatype get_type(thrust::device_vector<T>&& vec) {
+		return mpi_type_traits<T>::get_type( T() );
+	}
+
+	static inline element_addr_type get_addr(thrust::device_vector<T>& vec) {
+		return thrust::raw_pointer_cast( vec.data() );
+	}
+
+};
+#endif // THRUST_VERSION
+
+} // end mpi namespace
@@ -0,0 +1,177 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/error.h"
+#include "detail/comm.h"
+#include "detail/status.h"
+#include "detail/type_traits.h"
+
+#include <functional>
+#include <memory>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// dispatcher: an event-loop receiver for any-source workloads. A handler
+// is registered per tag and element type; for each registration a batch
+// of MPI_ANY_SOURCE receives is pre-posted (keeping messages out of the
+// unexpected queue) and completions are drained in bulk via MPI_Testsome,
+// recycling each buffer by re-posting it right after its handler ran:
+//
+// 		dispatcher disp;
+// 		disp.on<int>( WORK_TAG, [&](std::vector<int>& w, const status& s) {
+// 			schedule( s.source().rank(), w );
+// 		});
+// 		disp.run();						// until stop() is called
+//
+// Handlers always receive a vector of the registered element type, sized
+// to the actual message; single-value messages arrive as a vector of one
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class dispatcher {
+
+	// the type-erased behavior of one pre-posted receive: how to re-post
+	// its buffer and how to hand a completion to the user handler
+	struct slot {
+		std::function<void(MPI_Request&)> 		post;
+		std::function<void(const MPI_Status&)> 	deliver;
+	};
+
+	const comm& 				m_comm;
+	size_t 						m_depth;	// pre-posted recvs per handler
+	size_t 						m_max_elems;
+	bool 						m_stop;
+
+	std::vector<MPI_Request> 	m_reqs;
+	std::vector<slot> 			m_slots;
+
+	// scratch space for MPI_Testsome, reused across poll() calls
+	std::vector<int> 			m_indices;
+	std::vector<MPI_Status> 	m_statuses;
+
+	// Make this class non-copyable
+	dispatcher(const dispatcher& other) = delete;
+	dispatcher& operator=(const dispatcher& other) = delete;
+
+public:
+	dispatcher(const comm& com = comm::world,
+			   size_t depth = 4, size_t max_elems = 1024) :
+		m_comm(com), m_depth(depth), m_max_elems(max_elems), m_stop(false) { }
+
+	// Cancels the still pre-posted receives
+	~dispatcher() {
+		for(size_t i=0; i<m_reqs.size(); ++i) {
+			if ( m_reqs[i] == MPI_REQUEST_NULL ) { continue; }
+			MPI_Cancel( &m_reqs[i] );
+			MPI_Status stat;
+			MPI_Wait( &m_reqs[i], &stat );
+		}
+	}
+
+	// Registers a handler for messages of the given tag and element type,
+	// pre-posting the receive batch right away. The handler is invoked as
+	// fn(std::vector<T>&, status&) from within poll()/run()
+	template <class T, class Functor>
+	dispatcher& on(int tag, Functor&& fn) {
+		MPI_Datatype dt = mpi_type_traits<T>::get_type( T() );
+		std::function<void(std::vector<T>&, status&)> handler =
+			std::forward<Functor>(fn);
+
+		const comm& com = m_comm;
+		size_t max_elems = m_max_elems;
+
+		for(size_t i=0; i<m_depth; ++i) {
+			// the buffer is shared between the two closures and recycled
+			// across re-posts
+			auto buf = std::make_shared<std::vector<T>>(m_max_elems);
+
+			slot s;
+			s.post = [buf, dt, tag, &com, max_elems](MPI_Request& req) {
+				buf->resize(max_elems);
+				int err = MPI_Irecv( &buf->front(),
+						static_cast<int>(max_elems), dt,
+						MPI_ANY_SOURCE, tag, com.mpi_comm(), &req );
+				if ( err != MPI_SUCCESS ) {
+					MPP_REPORT_ERROR( err,
+						"Failed to pre-post receive for tag '" << tag << "'" );
+				}
+			};
+			s.deliver = [buf, dt, handler, &com](const MPI_Status& stat) {
+				int count;
+				MPI_Get_count( const_cast<MPI_Status*>(&stat), dt, &count );
+				buf->resize(count);
+				status st(com, stat, dt);
+				handler( *buf, st );
+			};
+
+			m_slots.push_back( std::move(s) );
+			m_reqs.push_back( MPI_REQUEST_NULL );
+			m_slots.back().post( m_reqs.back() );
+		}
+		return *this;
+	}
+
+	// Drains the completions accumulated so far (without blocking),
+	// invoking the matching handlers and re-posting the drained buffers.
+	// Returns the number of messages dispatched
+	inline size_t poll() {
+		if ( m_reqs.empty() ) { return 0; }
+
+		m_indices.resize( m_reqs.size() );
+		m_statuses.resize( m_reqs.size() );
+
+		int outcount = 0;
+		int err = MPI_Testsome( static_cast<int>(m_reqs.size()),
+				&m_reqs.front(), &outcount,
+				&m_indices.front(), &m_statuses.front() );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to test the pre-posted receives" );
+			return 0;
+		}
+
+		if ( outcount == MPI_UNDEFINED || outcount == 0 ) { return 0; }
+
+		for(int i=0; i<outcount; ++i) {
+			int idx = m_indices[i];
+			m_slots[idx].deliver( m_statuses[i] );
+			m_slots[idx].post( m_reqs[idx] );
+		}
+		return static_cast<size_t>(outcount);
+	}
+
+	// Dispatches until stop() is called (from a handler); returns the
+	// total number of messages dispatched
+	inline size_t run() {
+		m_stop = false;
+		size_t total = 0;
+		while( !m_stop ) { total += poll(); }
+		return total;
+	}
+
+	inline void stop() { m_stop = true; }
+
+};
+
+} // end mpi namespace
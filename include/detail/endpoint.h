@@ -20,14 +20,19 @@
  *
  ******************************************************************************/
 
-#pragma once 
+#pragma once
 
 #include "detail/decls.h"
+#include "detail/error.h"
+#include "detail/large_count.h"
+#include "detail/stats.h"
+
+#include <string>
 
 #define OVERLOAD_SEND(name, impl) \
 	template <class MsgType> \
 	inline endpoint& name(msg_impl<MsgType>&& m) { \
-		return name##_impl(impl, std::move(m)); \
+		return send_impl<impl>(std::move(m)); \
 	} \
 	template <class MsgType> \
 	inline endpoint& name(const msg_impl<MsgType>& m) { \
@@ -51,7 +56,7 @@ class endpoint {
 	const comm& 	m_comm;  // The MPI communicator this endpoing
 							 // belongs to
 
-	typedef int (*send_ptr)(void*,int,MPI_Datatype,int,int,MPI_Comm);
+	typedef int (*send_ptr)(const void*,int,MPI_Datatype,int,int,MPI_Comm);
 
 	// Make this class non-copyable 
 	endpoint(const endpoint& other) = delete;
@@ -65,9 +70,14 @@ public:
 		m_rank(other.m_rank), 
 		m_comm(std::move(other.m_comm)) { }
 
-	// Send a generic message to this endpoint (synchronously)
-	template <class MsgType> 
-	inline endpoint& send_impl(const send_ptr& func, msg_impl<MsgType>&& m);
+	// Send a generic message to this endpoint (synchronously). The MPI
+	// function is bound as a template argument rather than passed through
+	// a run-time function pointer, so every instantiation is a direct call
+	// the compiler can see through; for statically sized messages
+	// (scalars, std::array - see mpi_static_size) the count reaching MPI
+	// is then an immediate and the large-count check folds away
+	template <send_ptr Func, class MsgType>
+	inline endpoint& send_impl(msg_impl<MsgType>&& m);
 
 	// MPI_Send wrappers 
 	OVERLOAD_SEND(send, MPI_Send)
@@ -95,8 +105,59 @@ public:
 	}
 
 
+	// Creates a persistent send channel towards this endpoint (built upon
+	// MPI_Send_init, see channel.h)
+	template <class MsgType>
+	inline channel<MsgType> send_init(msg_impl<MsgType>&& m);
+
+	template <class MsgType>
+	inline channel<MsgType> send_init(const msg_impl<MsgType>& m) {
+		return send_init(std::move(m));
+	}
+
+	template <class RawMsg>
+	inline channel<const RawMsg> send_init(const RawMsg& m) {
+		return send_init( std::move( msg_impl<const RawMsg>(m) ) );
+	}
+
+	// Creates a persistent receive channel from this endpoint (built upon
+	// MPI_Recv_init, see channel.h)
+	template <class MsgType>
+	inline channel<MsgType> recv_init(msg_impl<MsgType>&& m);
+
+	template <class RawMsg>
+	inline channel<RawMsg> recv_init(RawMsg& m) {
+		return recv_init( std::move( msg_impl<RawMsg>(m) ) );
+	}
+
+	// Creates a persistent ready-mode send towards this endpoint, paired
+	// with a readiness handshake so MPI_Rsend is always legal (built upon
+	// MPI_Rsend_init, see ready.h)
+	template <class MsgType>
+	inline ready_sender<MsgType> rsend_init(msg_impl<MsgType>&& m);
+
+	template <class MsgType>
+	inline ready_sender<MsgType> rsend_init(const msg_impl<MsgType>& m) {
+		return rsend_init(std::move(m));
+	}
+
+	template <class RawMsg>
+	inline ready_sender<const RawMsg> rsend_init(const RawMsg& m) {
+		return rsend_init( std::move( msg_impl<const RawMsg>(m) ) );
+	}
+
+	// Creates the matching pre-posted receive side (see ready.h)
+	template <class MsgType>
+	inline ready_receiver<MsgType> rrecv_init(msg_impl<MsgType>&& m);
+
+	template <class RawMsg>
+	inline ready_receiver<RawMsg> rrecv_init(RawMsg& m) {
+		return rrecv_init( std::move( msg_impl<RawMsg>(m) ) );
+	}
+
+
 	template <class MsgType>
-	inline endpoint& operator<<(msg_impl<MsgType>&& m) { 
+	inline endpoint& operator<<(msg_impl<MsgType>&& m) {
 		return send(std::move(m)); 
 	}
 
@@ -130,6 +191,45 @@ public:
 		return operator>( std::move(msg_impl<RawType>(m)) );
 	}
 
+	// Receives a std::vector whose size is not known in advance: the
+	// matched message is probed (MPI_Mprobe), the vector resized once to
+	// the probed element count and the payload received directly into its
+	// storage (MPI_Mrecv). One message, no staging copy and no size
+	// pre-exchange
+	template <class T>
+	inline status probe_recv(std::vector<T>& vec, int tag = 0);
+
+	// As above for std::string: the payload lands straight in the string's
+	// own storage, resized to the probed length
+	inline status probe_recv(std::string& str, int tag = 0);
+
+	// Fused bidirectional transfer with this endpoint: one MPI_Sendrecv
+	// instead of a hand-ordered send/recv pair, so the library (not the
+	// caller) is responsible for avoiding the ordering deadlock
+	template <class SndType, class RcvType>
+	inline status exchange(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv);
+
+	template <class SndRaw, class RcvRaw>
+	inline status exchange(const SndRaw& snd, RcvRaw& rcv);
+
+	// Nonblocking variant: posts the receive and the send together and
+	// returns both as one request_set to wait on
+	template <class SndType, class RcvType>
+	inline request_set iexchange(msg_impl<SndType>&& snd,
+								 msg_impl<RcvType>&& rcv);
+
+	template <class SndRaw, class RcvRaw>
+	inline request_set iexchange(const SndRaw& snd, RcvRaw& rcv);
+
+	// Packed-serialization strategy for non-contiguous containers
+	// (list/set/map): elements are packed into a reusable arena buffer and
+	// shipped as one MPI_PACKED message (see packed.h)
+	template <class Container>
+	inline endpoint& send_packed(const Container& c, int tag = 0);
+
+	template <class Container>
+	inline status recv_packed(Container& c, int tag = 0);
+
 	// Returns the rank of this endpoit
 	inline const int& rank() const { return m_rank; }
 };
@@ -141,64 +241,90 @@ public:
 namespace mpi {
 
 // Send a generic message to this endpoint (synchronously)
-template <class MsgType>
-inline endpoint& endpoint::send_impl(const send_ptr& func, msg_impl<MsgType>&& m) {
-	MPI_Datatype&& dt = m.type();
-	if ( func(const_cast<void*>(static_cast<const void*>(m.addr())), 
-			  static_cast<int>(m.size()), dt,
-			  m_rank, 
-			  m.tag(), 
+template <endpoint::send_ptr Func, class MsgType>
+inline endpoint& endpoint::send_impl(msg_impl<MsgType>&& m) {
+	MPP_TIMER_START();
+	MPI_Datatype dt = m.type();
+	int count = static_cast<int>(m.size());
+	large_count_type big;
+	// a statically sized message can never overflow the int count, so the
+	// whole branch is dead code the compiler drops for these types
+	if ( !msg_impl<MsgType>::static_sized &&
+		 large_count_type::needed(m.size()) ) {
+		// beyond the int range: ship the whole payload as a single element
+		// of a derived type instead of truncating (see large_count.h)
+		big.reset( m.size(), dt );
+		dt = big.type();
+		count = 1;
+	}
+	int err = Func(const_cast<void*>(static_cast<const void*>(m.addr())),
+			  count, dt,
+			  m_rank,
+			  m.tag(),
 			  m_comm.mpi_comm()
-			) == MPI_SUCCESS ) {
-		return *this;
-	}
-	std::ostringstream ss;
-	ss << "ERROR in MPI rank '" << comm::world.rank()
-	   << "': Failed to send message to destination rank '"
-	   << m_rank << "'";
-	throw comm_error( ss.str() );
+			);
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to send message to destination rank '" << m_rank << "'" );
+	}
+	MPP_RECORD( 's', m_rank, count, dt, m.tag() );
+	return *this;
 }
 
 // Send a generic message to this endpoint (asynchronously)
 template <class MsgType>
 inline request<MsgType> endpoint::isend(msg_impl<MsgType>&& m) {
-	MPI_Datatype&& dt = m.type();
-	MPI_Request req;
-	if ( MPI_Isend( const_cast<void*>(static_cast<const void*>(m.addr())), 
-			  		static_cast<int>(m.size()), dt,
-			  		m_rank, 
-			  		m.tag(), 
+	MPP_TIMER_START();
+	MPI_Datatype dt = m.type();
+	int count = static_cast<int>(m.size());
+	large_count_type big;
+	if ( large_count_type::needed(m.size()) ) {
+		// MPI defers the deallocation of the derived type until the
+		// pending send completed, so 'big' may leave scope right away
+		big.reset( m.size(), dt );
+		dt = big.type();
+		count = 1;
+	}
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Isend( const_cast<void*>(static_cast<const void*>(m.addr())),
+			  		count, dt,
+			  		m_rank,
+			  		m.tag(),
 			  		m_comm.mpi_comm(),
 			  		&req
-				) != MPI_SUCCESS ) 
-	{
-		std::ostringstream ss;
-		ss << "ERROR in MPI rank '" << comm::world.rank()
-		   << "': Failed to send message to destination rank '"
-		   << m_rank << "'";
-
-		throw comm_error( ss.str() );
+				);
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to send message to destination rank '" << m_rank << "'" );
 	}
+	// for nonblocking sends the elapsed time covers the posting only
+	MPP_RECORD( 'i', m_rank, count, dt, m.tag() );
 	return request<MsgType>(m_comm, req, std::move(m));
 }
 
 // Receive from this endpoing (asynchronously)
 template <class MsgType>
 inline request<MsgType> endpoint::operator>(msg_impl<MsgType>&& m) {
-	MPI_Request req;
-	if( MPI_Irecv( static_cast<void*>(m.addr()), 
-				   static_cast<int>(m.size()), 
-				   m.type(),
-				   m_rank, 
-				   m.tag(), 
-				   m_comm.mpi_comm(), 
+	MPI_Datatype dt = m.type();
+	int count = static_cast<int>(m.size());
+	large_count_type big;
+	if ( large_count_type::needed(m.size()) ) {
+		big.reset( m.size(), dt );
+		dt = big.type();
+		count = 1;
+	}
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Irecv( static_cast<void*>(m.addr()),
+				   count,
+				   dt,
+				   m_rank,
+				   m.tag(),
+				   m_comm.mpi_comm(),
 				   &req
-				 ) != MPI_SUCCESS ) {
-		std::ostringstream ss;
-		ss << "ERROR in MPI rank '" << comm::world.rank()
-		   << "': Failed to receive message from destination rank '"
-		   << m_rank << "'";
-		throw comm_error( ss.str() );
+				 );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to receive message from destination rank '" << m_rank << "'" );
 	}
 	return request<MsgType>(m_comm, req, std::move(m));
 }
@@ -207,6 +333,7 @@ inline request<MsgType> endpoint::operator>(msg_impl<MsgType>&& m) {
 
 
 #include "detail/status.h"
+#include "detail/type_traits.h"
 
 namespace mpi {
 
@@ -217,22 +344,126 @@ inline status endpoint::operator>>(RawType& m) {
 
 template <class MsgType>
 inline status endpoint::operator>>(msg_impl<MsgType>&& m) {
-	status::mpi_status_ptr stat( new MPI_Status );
+	MPP_TIMER_START();
+	MPI_Status stat = MPI_Status();
 	MPI_Datatype dt = m.type();
-	if(MPI_Recv( const_cast<void*>(static_cast<const void*>(m.addr())), 
-				 static_cast<int>(m.size()), dt,
-				 m_rank, 
-				 m.tag(), 
-				 m_comm.mpi_comm(), 
-				 stat.get()
-			   ) == MPI_SUCCESS ) {
-		return status(m_comm, std::move(stat), dt);
-	}
-	std::ostringstream ss;
-	ss << "ERROR in MPI rank '" << comm::world.rank()
-	   << "': Failed to receive message from destination rank '"
-	   << m_rank << "'";
-	throw comm_error( ss.str() );
+	int count = static_cast<int>(m.size());
+	large_count_type big;
+	if ( large_count_type::needed(m.size()) ) {
+		big.reset( m.size(), dt );
+		dt = big.type();
+		count = 1;
+	}
+	int err = MPI_Recv( const_cast<void*>(static_cast<const void*>(m.addr())),
+				 count, dt,
+				 m_rank,
+				 m.tag(),
+				 m_comm.mpi_comm(),
+				 &stat
+			   );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to receive message from destination rank '" << m_rank << "'" );
+	}
+	MPP_RECORD( 'r', stat.MPI_SOURCE, count, dt, m.tag() );
+	// the status must reference the element type, not the derived
+	// large-count type: the receive already completed, so 'big' frees its
+	// type on return and a later status::count() would read a dangling
+	// handle
+	return status(m_comm, stat, m.type());
 }
 
-} // end mpi namespace 
+template <class T>
+inline status endpoint::probe_recv(std::vector<T>& vec, int tag) {
+	MPI_Message msg;
+	MPI_Status stat = MPI_Status();
+	MPI_Datatype dt = mpi_type_traits<T>::get_type( T() );
+
+	int err = MPI_Mprobe( m_rank, tag, m_comm.mpi_comm(), &msg, &stat );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to probe message from destination rank '" << m_rank << "'" );
+		return status(m_comm, stat, dt);
+	}
+
+	int count;
+	MPI_Get_count( &stat, dt, &count );
+	vec.resize( count );
+
+	err = MPI_Mrecv( count == 0 ? NULL : &vec.front(), count, dt, &msg, &stat );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to receive message from destination rank '" << m_rank << "'" );
+	}
+	return status(m_comm, stat, dt);
+}
+
+template <class SndType, class RcvType>
+inline status endpoint::exchange(msg_impl<SndType>&& snd, msg_impl<RcvType>&& rcv) {
+	MPI_Status stat = MPI_Status();
+	MPI_Datatype rdt = rcv.type();
+	int err = MPI_Sendrecv(
+			const_cast<void*>(static_cast<const void*>(snd.addr())),
+			static_cast<int>(snd.size()), snd.type(),
+			m_rank, snd.tag(),
+			static_cast<void*>(rcv.addr()),
+			static_cast<int>(rcv.size()), rdt,
+			m_rank, rcv.tag(),
+			m_comm.mpi_comm(), &stat );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to exchange messages with rank '" << m_rank << "'" );
+	}
+	return status(m_comm, stat, rdt);
+}
+
+template <class SndRaw, class RcvRaw>
+inline status endpoint::exchange(const SndRaw& snd, RcvRaw& rcv) {
+	return exchange( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv) );
+}
+
+inline status endpoint::probe_recv(std::string& str, int tag) {
+	MPI_Message msg;
+	MPI_Status stat = MPI_Status();
+
+	int err = MPI_Mprobe( m_rank, tag, m_comm.mpi_comm(), &msg, &stat );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to probe message from destination rank '" << m_rank << "'" );
+		return status(m_comm, stat, MPI_CHAR);
+	}
+
+	int count;
+	MPI_Get_count( &stat, MPI_CHAR, &count );
+	str.resize( count );
+
+	err = MPI_Mrecv( count == 0 ? NULL : &str[0], count, MPI_CHAR, &msg, &stat );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to receive message from destination rank '" << m_rank << "'" );
+	}
+	return status(m_comm, stat, MPI_CHAR);
+}
+
+} // end mpi namespace
+
+#include "detail/request_set.h"
+
+namespace mpi {
+
+template <class SndType, class RcvType>
+inline request_set endpoint::iexchange(msg_impl<SndType>&& snd,
+									   msg_impl<RcvType>&& rcv) {
+	request_set set(m_comm);
+	// post the receive before the send, as a hand-written pair should
+	set.add( operator>( std::move(rcv) ) );
+	set.add( isend( std::move(snd) ) );
+	return set;
+}
+
+template <class SndRaw, class RcvRaw>
+inline request_set endpoint::iexchange(const SndRaw& snd, RcvRaw& rcv) {
+	return iexchange( msg_impl<const SndRaw>(snd), msg_impl<RcvRaw>(rcv) );
+}
+
+} // end mpi namespace
@@ -0,0 +1,68 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * Error handling policy. By default a failed MPI call raises a comm_error
+ * carrying a descriptive message. Compiling with -DMPP_ERROR_CODES selects
+ * a noexcept mode instead: mpi::init sets the errhandler of the world
+ * communicator to MPI_ERRORS_RETURN, a failed call records its error code
+ * (retrievable per thread via mpi::last_error()) and the hot path contains
+ * no stream or exception machinery, leaving the success path as just the
+ * MPI call.
+ */
+
+#include "detail/decls.h"
+
+namespace mpi {
+
+// Per-thread slot holding the code of the last failed MPI call
+// (MPP_ERROR_CODES mode only, MPI_SUCCESS when no failure occurred)
+inline int& last_error_ref() {
+	static thread_local int code = MPI_SUCCESS;
+	return code;
+}
+
+inline int last_error() { return last_error_ref(); }
+
+inline void clear_last_error() { last_error_ref() = MPI_SUCCESS; }
+
+} // end mpi namespace
+
+/**
+ * Reports a failed MPI call: throws a comm_error built from the streamed
+ * message expression, or - in MPP_ERROR_CODES mode - just records the error
+ * code and falls through to the enclosing function's return
+ */
+#if defined(MPP_ERROR_CODES)
+	#define MPP_REPORT_ERROR(ErrCode, MsgExpr) \
+		mpi::last_error_ref() = (ErrCode)
+#else
+	#define MPP_REPORT_ERROR(ErrCode, MsgExpr) \
+		do { \
+			std::ostringstream _mpp_ss; \
+			_mpp_ss << "ERROR in MPI rank '" << mpi::comm::world.rank() \
+					<< "': " << MsgExpr; \
+			throw mpi::comm_error( _mpp_ss.str() ); \
+		} while(0)
+#endif
@@ -0,0 +1,261 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/error.h"
+#include "detail/large_count.h"
+#include "detail/message.h"
+#include "detail/request.h"
+
+#include <string>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// file: wraps an MPI-IO file handle, playing for parallel I/O the role
+// endpoint plays for point-to-point messages. The file is opened
+// collectively over a communicator; positioning through at(offset) yields a
+// cursor which streams typed messages to and from the file:
+//
+// 		file f("out.bin", comm::world);
+// 		f.at( rank * block_bytes ) << msg(vec);		// collective write
+// 		f.at( rank * block_bytes ) >> msg(vec);		// collective read
+//
+// The blocking streaming operators map onto MPI_File_write_at_all /
+// MPI_File_read_at_all, so the MPI library can coalesce the accesses of all
+// ranks into large contiguous file operations (two-phase I/O). iwrite() and
+// iread() are the nonblocking counterparts and return a request<T> to wait
+// on. The element datatype and count are derived from the message through
+// mpi_type_traits, exactly as for sends; offsets are expressed in bytes
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class file {
+
+	MPI_File 		m_file;
+	const comm& 	m_comm;
+
+	// Make this class non-copyable
+	file(const file& other) = delete;
+	file& operator=(const file& other) = delete;
+
+public:
+
+	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	// cursor: a position within the file, obtained via file::at(). The
+	// streaming operators advance the cursor by the number of bytes
+	// transferred, so consecutive messages land back to back
+	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	class cursor {
+
+		file& 		m_file;
+		MPI_Offset 	m_offset;
+
+		cursor(file& f, MPI_Offset offset) :
+			m_file(f), m_offset(offset) { }
+
+		friend class file;
+
+	public:
+
+		// Collective write of the message at the cursor position (all
+		// ranks of the communicator must participate)
+		template <class MsgType>
+		inline cursor& operator<<(msg_impl<MsgType>&& m) {
+			MPI_Datatype dt = m.type();
+			int count = static_cast<int>(m.size());
+			large_count_type big;
+			if ( large_count_type::needed(m.size()) ) {
+				big.reset( m.size(), dt );
+				dt = big.type();
+				count = 1;
+			}
+			int err = MPI_File_write_at_all( m_file.m_file, m_offset,
+						const_cast<void*>(static_cast<const void*>(m.addr())),
+						count, dt, MPI_STATUS_IGNORE );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to write message at file offset '"
+						<< m_offset << "'" );
+			}
+			advance( m.type(), m.size() );
+			return *this;
+		}
+
+		template <class MsgType>
+		inline cursor& operator<<(const msg_impl<MsgType>& m) {
+			return operator<<(std::move(m));
+		}
+
+		template <class RawType>
+		inline cursor& operator<<(const RawType& m) {
+			return operator<<( std::move( msg_impl<const RawType>(m) ) );
+		}
+
+		// Collective read of the message at the cursor position (all
+		// ranks of the communicator must participate)
+		template <class MsgType>
+		inline cursor& operator>>(msg_impl<MsgType>&& m) {
+			MPI_Datatype dt = m.type();
+			int count = static_cast<int>(m.size());
+			large_count_type big;
+			if ( large_count_type::needed(m.size()) ) {
+				big.reset( m.size(), dt );
+				dt = big.type();
+				count = 1;
+			}
+			int err = MPI_File_read_at_all( m_file.m_file, m_offset,
+						const_cast<void*>(static_cast<const void*>(m.addr())),
+						count, dt, MPI_STATUS_IGNORE );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to read message at file offset '"
+						<< m_offset << "'" );
+			}
+			advance( m.type(), m.size() );
+			return *this;
+		}
+
+		template <class RawType>
+		inline cursor& operator>>(RawType& m) {
+			return operator>>( std::move( msg_impl<RawType>(m) ) );
+		}
+
+		// Nonblocking write of the message at the cursor position; the
+		// returned request is waited on like any other (see request.h)
+		template <class MsgType>
+		inline request<MsgType> iwrite(msg_impl<MsgType>&& m) {
+			MPI_Request req;
+			int err = MPI_File_iwrite_at( m_file.m_file, m_offset,
+						const_cast<void*>(static_cast<const void*>(m.addr())),
+						static_cast<int>(m.size()), m.type(), &req );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to post nonblocking write at file offset '"
+						<< m_offset << "'" );
+			}
+			advance( m.type(), m.size() );
+			return request<MsgType>( m_file.m_comm, req, std::move(m) );
+		}
+
+		template <class MsgType>
+		inline request<MsgType> iwrite(const msg_impl<MsgType>& m) {
+			return iwrite(std::move(m));
+		}
+
+		template <class RawType>
+		inline request<const RawType> iwrite(const RawType& m) {
+			return iwrite( std::move( msg_impl<const RawType>(m) ) );
+		}
+
+		// Nonblocking read of the message at the cursor position
+		template <class MsgType>
+		inline request<MsgType> iread(msg_impl<MsgType>&& m) {
+			MPI_Request req;
+			int err = MPI_File_iread_at( m_file.m_file, m_offset,
+						const_cast<void*>(static_cast<const void*>(m.addr())),
+						static_cast<int>(m.size()), m.type(), &req );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to post nonblocking read at file offset '"
+						<< m_offset << "'" );
+			}
+			advance( m.type(), m.size() );
+			return request<MsgType>( m_file.m_comm, req, std::move(m) );
+		}
+
+		template <class RawType>
+		inline request<RawType> iread(RawType& m) {
+			return iread( std::move( msg_impl<RawType>(m) ) );
+		}
+
+		inline MPI_Offset offset() const { return m_offset; }
+
+	private:
+		void advance(const MPI_Datatype& dt, size_t count) {
+			int type_size;
+			MPI_Type_size( dt, &type_size );
+			m_offset += static_cast<MPI_Offset>(type_size) * count;
+		}
+	};
+
+	// Opens (collectively) the file at the given path over the given
+	// communicator; by default the file is created when absent and opened
+	// for both reading and writing
+	file(const std::string& path, const comm& com = comm::world,
+		 int amode = MPI_MODE_CREATE | MPI_MODE_RDWR) : m_comm(com)
+	{
+		int err = MPI_File_open( com.mpi_comm(),
+					const_cast<char*>(path.c_str()), amode,
+					MPI_INFO_NULL, &m_file );
+		if ( err != MPI_SUCCESS ) {
+			m_file = MPI_FILE_NULL;
+			MPP_REPORT_ERROR( err,
+				"Failed to open file '" << path << "'" );
+		}
+	}
+
+	file(file&& other) :
+		m_file(other.m_file), m_comm(std::move(other.m_comm))
+	{
+		other.m_file = MPI_FILE_NULL;
+	}
+
+	~file() { close(); }
+
+	// Positions a cursor at the given byte offset
+	inline cursor at(MPI_Offset offset) {
+		return cursor(*this, offset);
+	}
+
+	// Forces the written data out to the storage device (collective)
+	inline void sync() {
+		int err = MPI_File_sync(m_file);
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to sync file" );
+		}
+	}
+
+	// Current size of the file, in bytes
+	inline MPI_Offset size() const {
+		MPI_Offset size;
+		MPI_File_get_size(m_file, &size);
+		return size;
+	}
+
+	// Closes the file (collective); invoked by the destructor as well
+	inline void close() {
+		if ( m_file != MPI_FILE_NULL ) {
+			MPI_File_close(&m_file);
+			m_file = MPI_FILE_NULL;
+		}
+	}
+
+	// Deletes the file at the given path (to be called by a single rank)
+	static inline void remove(const std::string& path) {
+		MPI_File_delete( const_cast<char*>(path.c_str()), MPI_INFO_NULL );
+	}
+
+};
+
+} // end mpi namespace
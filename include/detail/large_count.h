@@ -0,0 +1,123 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include <climits>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// large_count_type: the classic MPI entry points take the element count as
+// an int, silently truncating payloads beyond 2^31-1 elements. When a
+// message exceeds that bound the send/recv paths (see endpoint.h) wrap the
+// whole payload into one committed derived type built here and transfer a
+// single element of it, so arbitrarily large buffers move in one call with
+// no user-side chunking loop.
+//
+// On an MPI-4 library the type is a plain large-count contiguous; earlier
+// libraries get the equivalent chunked layout: a vector of full chunks
+// followed by the remainder, glued together by a struct type.
+//
+// The committed type is released on destruction; MPI defers the
+// deallocation past any nonblocking operation still using it, so the
+// wrapper may safely go out of scope right after the call is issued
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class large_count_type {
+
+	MPI_Datatype m_type;
+
+	// Make this class non-copyable
+	large_count_type(const large_count_type& other) = delete;
+	large_count_type& operator=(const large_count_type& other) = delete;
+
+public:
+	// width of a full chunk in the pre-MPI-4 layout (overridable mainly to
+	// make the chunked path testable with small payloads)
+	static const size_t default_chunk = 1u << 30;
+
+	large_count_type() : m_type(MPI_DATATYPE_NULL) { }
+
+	large_count_type(size_t count, const MPI_Datatype& dt,
+					 size_t chunk = default_chunk) :
+		m_type(MPI_DATATYPE_NULL)
+	{
+		reset(count, dt, chunk);
+	}
+
+	~large_count_type() {
+		if ( m_type != MPI_DATATYPE_NULL ) { MPI_Type_free(&m_type); }
+	}
+
+	// true when the given element count cannot go through the classic
+	// int-count entry points untruncated
+	static inline bool needed(size_t count) {
+		return count > static_cast<size_t>(INT_MAX);
+	}
+
+	// (Re)builds the committed type describing 'count' contiguous elements
+	// of the given datatype
+	inline void reset(size_t count, const MPI_Datatype& dt,
+					  size_t chunk = default_chunk) {
+		if ( m_type != MPI_DATATYPE_NULL ) { MPI_Type_free(&m_type); }
+
+#if MPI_VERSION >= 4
+		(void) chunk;
+		MPI_Type_contiguous_c( static_cast<MPI_Count>(count), dt, &m_type );
+#else
+		size_t quot = count / chunk;
+		size_t rem  = count % chunk;
+		assert( quot <= static_cast<size_t>(INT_MAX) &&
+				"Element count not representable even when chunked" );
+
+		MPI_Datatype chunks;
+		MPI_Type_vector( static_cast<int>(quot), static_cast<int>(chunk),
+						 static_cast<int>(chunk), dt, &chunks );
+
+		if ( rem == 0 ) {
+			m_type = chunks;
+		} else {
+			MPI_Aint lb, extent;
+			MPI_Type_get_extent( dt, &lb, &extent );
+
+			int 		 blocklens[2] = { 1, static_cast<int>(rem) };
+			MPI_Aint 	 disps[2] = { 0,
+				static_cast<MPI_Aint>(quot * chunk) * extent };
+			MPI_Datatype types[2] = { chunks, dt };
+
+			MPI_Type_create_struct( 2, blocklens, disps, types, &m_type );
+			MPI_Type_free( &chunks );
+		}
+#endif
+		MPI_Type_commit( &m_type );
+	}
+
+	inline const MPI_Datatype& type() const {
+		assert( m_type != MPI_DATATYPE_NULL && "Type was never built" );
+		return m_type;
+	}
+
+};
+
+} // end mpi namespace
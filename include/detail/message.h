@@ -37,6 +37,12 @@ struct msg_impl {
 
 	typedef MsgTy value_type;
 
+	// Compile-time extent of the message, for types which carry it in the
+	// type itself (see mpi_static_size); run-time sized messages report
+	// static_sized = false
+	static const bool 	static_sized = mpi_static_size<value_type>::known;
+	static const size_t static_size  = mpi_static_size<value_type>::value;
+
 	// Builds a msg wrapping v
 	msg_impl(value_type& v, int tag = 0) : m_data(v), m_tag(tag) { }
 
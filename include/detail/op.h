@@ -0,0 +1,190 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/error.h"
+#include "detail/comm.h"
+#include "detail/type_traits.h"
+
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Reduction operation mapping: the reduce/allreduce members accept C++
+// function objects and resolve them to an MPI_Op at compile time when the
+// functor is a recognized one (std::plus -> MPI_SUM, ...), so the MPI
+// library keeps using its (possibly hardware-offloaded) built-in
+// reductions. Unrecognized commutative functors - including lambdas - are
+// registered once through MPI_Op_create and memoized in the op_cache,
+// mirroring what the datatype_cache does for derived types
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// min/max function objects (std::min/std::max are functions, not functors)
+template <class T>
+struct minimum {
+	inline T operator()(const T& lhs, const T& rhs) const {
+		return rhs < lhs ? rhs : lhs;
+	}
+};
+
+template <class T>
+struct maximum {
+	inline T operator()(const T& lhs, const T& rhs) const {
+		return lhs < rhs ? rhs : lhs;
+	}
+};
+
+// compile-time functor -> MPI_Op mapping; the primary template marks the
+// functor as custom, the macro below registers the built-in ones
+template <class Op>
+struct op_map {
+	static const bool is_builtin = false;
+};
+
+#define MPP_BUILTIN_OP(Functor, MpiOp) \
+	template <class T> \
+	struct op_map<Functor<T>> { \
+		static const bool is_builtin = true; \
+		static inline MPI_Op get() { return MpiOp; } \
+	};
+
+MPP_BUILTIN_OP(std::plus, 			MPI_SUM)
+MPP_BUILTIN_OP(std::multiplies, 	MPI_PROD)
+MPP_BUILTIN_OP(std::logical_and, 	MPI_LAND)
+MPP_BUILTIN_OP(std::logical_or, 	MPI_LOR)
+MPP_BUILTIN_OP(std::bit_and, 		MPI_BAND)
+MPP_BUILTIN_OP(std::bit_or, 		MPI_BOR)
+MPP_BUILTIN_OP(std::bit_xor, 		MPI_BXOR)
+MPP_BUILTIN_OP(minimum, 			MPI_MIN)
+MPP_BUILTIN_OP(maximum, 			MPI_MAX)
+
+#undef MPP_BUILTIN_OP
+
+// Keeps the functor instance reachable from the plain-function trampoline
+// handed to MPI_Op_create (one per element-type/functor combination)
+template <class T, class Op>
+struct op_holder {
+	static inline Op*& instance() {
+		static Op* op = NULL;
+		return op;
+	}
+
+	// the MPI_User_function: folds the incoming vector into inout
+	static void apply(void* invec, void* inoutvec, int* len, MPI_Datatype*) {
+		const T* in = static_cast<const T*>(invec);
+		T* inout = static_cast<T*>(inoutvec);
+		Op& op = *instance();
+		for(int i=0; i<*len; ++i) {
+			inout[i] = op( in[i], inout[i] );
+		}
+	}
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// op_cache: memoizes the MPI_Op handles created for custom functors; the
+// registration (MPI_Op_create) happens once per element-type/functor
+// combination, handles are freed by mpi::finalize()
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class op_cache {
+
+	std::unordered_map<std::type_index, MPI_Op> m_cache;
+
+	op_cache() { }
+
+	// Make this class non-copyable
+	op_cache(const op_cache& other) = delete;
+	op_cache& operator=(const op_cache& other) = delete;
+
+public:
+	static op_cache& instance() {
+		static op_cache cache;
+		return cache;
+	}
+
+	// Returns the (possibly freshly registered) MPI_Op applying the given
+	// functor element-wise; the functor must be commutative
+	template <class T, class Op>
+	inline MPI_Op lookup(const Op& op) {
+		std::type_index key( typeid(op_holder<T,Op>) );
+
+		auto fit = m_cache.find(key);
+		if ( fit != m_cache.end() ) { return fit->second; }
+
+		if ( !op_holder<T,Op>::instance() ) {
+			op_holder<T,Op>::instance() = new Op(op);
+		}
+
+		MPI_Op mpi_op = MPI_OP_NULL;
+		int err = MPI_Op_create( &op_holder<T,Op>::apply, 1, &mpi_op );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to register the reduction operation" );
+			return MPI_OP_NULL;
+		}
+
+		m_cache.emplace( key, mpi_op );
+		return mpi_op;
+	}
+
+	// Releases the registered handles (invoked by mpi::finalize())
+	inline void clear() {
+		for(auto& entry : m_cache) {
+			MPI_Op_free( &entry.second );
+		}
+		m_cache.clear();
+	}
+
+};
+
+// Resolves a functor to its MPI_Op for reductions over elements of type T
+template <class T, class Op>
+inline typename std::enable_if<op_map<Op>::is_builtin, MPI_Op>::type
+mpi_op(const Op&) {
+	return op_map<Op>::get();
+}
+
+template <class T, class Op>
+inline typename std::enable_if<!op_map<Op>::is_builtin, MPI_Op>::type
+mpi_op(const Op& op) {
+	return op_cache::instance().lookup<T>(op);
+}
+
+template <class SndRaw, class RcvRaw, class Op>
+inline comm& comm::reduce(const SndRaw& snd, RcvRaw& rcv, Op op, int root) {
+	typedef typename std::remove_const<
+		typename mpi_type_traits<RcvRaw>::element_type>::type elem_type;
+	return reduce( snd, rcv, mpi_op<elem_type>(op), root );
+}
+
+template <class SndRaw, class RcvRaw, class Op>
+inline comm& comm::allreduce(const SndRaw& snd, RcvRaw& rcv, Op op) {
+	typedef typename std::remove_const<
+		typename mpi_type_traits<RcvRaw>::element_type>::type elem_type;
+	return allreduce( snd, rcv, mpi_op<elem_type>(op) );
+}
+
+} // end mpi namespace
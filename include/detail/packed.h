@@ -0,0 +1,200 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/error.h"
+#include "detail/endpoint.h"
+#include "detail/type_traits.h"
+
+#include <utility>
+#include <type_traits>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Packed-serialization transfer strategy for non-contiguous containers
+// (lists, sets, maps). The std::list traits build a derived datatype
+// whose displacements are only valid for that exact instance, committed
+// and thrown away per send; packing the elements into a hot, grow-only
+// arena buffer (recycled across sends, one per thread) and shipping them
+// as MPI_PACKED is far cheaper and works for any iterable container:
+//
+// 		comm::world(1).send_packed( adjacency );	// std::map/set/list
+// 		comm::world(0).recv_packed( adjacency );
+//
+// The wire format is an int element count followed by the packed
+// elements; pairs (map entries) pack their two halves in sequence
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// pack_arena: the staging buffer reused by every packed transfer of this
+// thread; it only ever grows, so steady-state sends allocate nothing
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+struct pack_arena {
+	static inline std::vector<char>& buffer() {
+		static thread_local std::vector<char> buf;
+		return buf;
+	}
+
+	static inline void reserve(size_t bytes) {
+		std::vector<char>& buf = buffer();
+		if ( buf.size() < bytes ) { buf.resize(bytes); }
+	}
+};
+
+// The element type reconstructed on the receive side: map entries arrive
+// as a mutable pair (their key constness belongs to the container)
+template <class T>
+struct packed_value {
+	typedef typename std::remove_const<T>::type type;
+};
+
+template <class F, class S>
+struct packed_value<std::pair<F,S>> {
+	typedef std::pair<typename std::remove_const<F>::type,
+					  typename std::remove_const<S>::type> type;
+};
+
+// Packed size, pack and unpack of a single element; the std::pair
+// overloads recurse over the two halves (nested pairs compose)
+template <class T>
+inline int packed_size_one(const T&, const MPI_Comm& com) {
+	typedef typename std::remove_const<T>::type U;
+	int bytes = 0;
+	MPI_Pack_size( 1, mpi_type_traits<U>::get_type( U() ), com, &bytes );
+	return bytes;
+}
+
+template <class F, class S>
+inline int packed_size_one(const std::pair<F,S>& p, const MPI_Comm& com) {
+	return packed_size_one(p.first, com) + packed_size_one(p.second, com);
+}
+
+template <class T>
+inline void pack_one(const T& v, std::vector<char>& buf, int& pos,
+					 const MPI_Comm& com) {
+	typedef typename std::remove_const<T>::type U;
+	MPI_Pack( const_cast<U*>(&v), 1,
+			  mpi_type_traits<U>::get_type( U() ),
+			  &buf.front(), static_cast<int>(buf.size()), &pos, com );
+}
+
+template <class F, class S>
+inline void pack_one(const std::pair<F,S>& p, std::vector<char>& buf,
+					 int& pos, const MPI_Comm& com) {
+	pack_one(p.first, buf, pos, com);
+	pack_one(p.second, buf, pos, com);
+}
+
+template <class T>
+inline void unpack_one(T& v, std::vector<char>& buf, int& pos,
+					   const MPI_Comm& com) {
+	MPI_Unpack( &buf.front(), static_cast<int>(buf.size()), &pos,
+				&v, 1, mpi_type_traits<T>::get_type( T() ), com );
+}
+
+template <class F, class S>
+inline void unpack_one(std::pair<F,S>& p, std::vector<char>& buf, int& pos,
+					   const MPI_Comm& com) {
+	unpack_one(p.first, buf, pos, com);
+	unpack_one(p.second, buf, pos, com);
+}
+
+// Packs the container elements into the arena and ships them as one
+// MPI_PACKED message
+template <class Container>
+inline endpoint& endpoint::send_packed(const Container& c, int tag) {
+	const MPI_Comm& com = m_comm.mpi_comm();
+	std::vector<char>& buf = pack_arena::buffer();
+
+	int total = 0;
+	MPI_Pack_size( 1, MPI_INT, com, &total );	// the leading element count
+	for(typename Container::const_iterator it = c.begin();
+		it != c.end(); ++it) {
+		total += packed_size_one(*it, com);
+	}
+	pack_arena::reserve(total);
+
+	int pos = 0;
+	int count = static_cast<int>( c.size() );
+	MPI_Pack( &count, 1, MPI_INT,
+			  &buf.front(), static_cast<int>(buf.size()), &pos, com );
+	for(typename Container::const_iterator it = c.begin();
+		it != c.end(); ++it) {
+		pack_one(*it, buf, pos, com);
+	}
+
+	int err = MPI_Send( &buf.front(), pos, MPI_PACKED, m_rank, tag, com );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to send packed message to destination rank '"
+				<< m_rank << "'" );
+	}
+	return *this;
+}
+
+// Receives one packed message (sized by the probe) and refills the
+// container from its elements
+template <class Container>
+inline status endpoint::recv_packed(Container& c, int tag) {
+	const MPI_Comm& com = m_comm.mpi_comm();
+	std::vector<char>& buf = pack_arena::buffer();
+
+	MPI_Message pmsg;
+	MPI_Status stat = MPI_Status();
+	int err = MPI_Mprobe( m_rank, tag, com, &pmsg, &stat );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to probe packed message from destination rank '"
+				<< m_rank << "'" );
+		return status(m_comm, stat, MPI_PACKED);
+	}
+
+	int bytes;
+	MPI_Get_count( &stat, MPI_PACKED, &bytes );
+	pack_arena::reserve(bytes);
+
+	err = MPI_Mrecv( &buf.front(), bytes, MPI_PACKED, &pmsg, &stat );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to receive packed message from destination rank '"
+				<< m_rank << "'" );
+		return status(m_comm, stat, MPI_PACKED);
+	}
+
+	int pos = 0;
+	int count = 0;
+	MPI_Unpack( &buf.front(), bytes, &pos, &count, 1, MPI_INT, com );
+
+	c.clear();
+	for(int i=0; i<count; ++i) {
+		typename packed_value<typename Container::value_type>::type v;
+		unpack_one(v, buf, pos, com);
+		c.insert( c.end(), v );
+	}
+	return status(m_comm, stat, MPI_PACKED);
+}
+
+} // end mpi namespace
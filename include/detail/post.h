@@ -0,0 +1,163 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/comm.h"
+#include "detail/error.h"
+#include "detail/large_count.h"
+#include "detail/message.h"
+#include "detail/request_set.h"
+#include "detail/stats.h"
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Batch submission of nonblocking operations. isend_to()/irecv_from() build
+// lightweight descriptors which comm::post() turns into back-to-back
+// MPI_Isend/MPI_Irecv calls after a single communicator validation, the
+// handles landing directly in one contiguous request_set:
+//
+// 		auto set = comm::world.post( isend_to(1, msg(a)),
+// 									 isend_to(2, msg(b)),
+// 									 irecv_from(3, msg(c)) );
+// 		set.wait_all();
+//
+// Compared to collecting individual endpoint isends, nothing is validated
+// or looked up per operation and no request<T> objects are created and
+// absorbed one by one: the set is ready for the batched wait primitives the
+// moment post() returns
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class MsgType>
+struct isend_op {
+
+	isend_op(int rank, msg_impl<MsgType>&& m) :
+		m_rank(rank), m_msg(std::move(m)) { }
+
+	isend_op(isend_op<MsgType>&& other) :
+		m_rank(other.m_rank), m_msg(std::move(other.m_msg)) { }
+
+	int 				m_rank;
+	msg_impl<MsgType> 	m_msg;
+};
+
+template <class MsgType>
+struct irecv_op {
+
+	irecv_op(int rank, msg_impl<MsgType>&& m) :
+		m_rank(rank), m_msg(std::move(m)) { }
+
+	irecv_op(irecv_op<MsgType>&& other) :
+		m_rank(other.m_rank), m_msg(std::move(other.m_msg)) { }
+
+	int 				m_rank;
+	msg_impl<MsgType> 	m_msg;
+};
+
+// Describes a nonblocking send towards the given rank, to be posted via
+// comm::post()
+template <class MsgType>
+inline isend_op<MsgType> isend_to(int rank, msg_impl<MsgType>&& m) {
+	return isend_op<MsgType>( rank, std::move(m) );
+}
+
+template <class RawType>
+inline isend_op<const RawType> isend_to(int rank, const RawType& m) {
+	return isend_op<const RawType>( rank, msg_impl<const RawType>(m) );
+}
+
+// Describes a nonblocking receive from the given rank, to be posted via
+// comm::post()
+template <class MsgType>
+inline irecv_op<MsgType> irecv_from(int rank, msg_impl<MsgType>&& m) {
+	return irecv_op<MsgType>( rank, std::move(m) );
+}
+
+template <class RawType>
+inline irecv_op<RawType> irecv_from(int rank, RawType& m) {
+	return irecv_op<RawType>( rank, msg_impl<RawType>(m) );
+}
+
+template <class MsgType>
+inline void comm::post_one(request_set& set, isend_op<MsgType>&& op) {
+	MPP_TIMER_START();
+	MPI_Datatype dt = op.m_msg.type();
+	int count = static_cast<int>(op.m_msg.size());
+	large_count_type big;
+	if ( !msg_impl<MsgType>::static_sized &&
+		 large_count_type::needed(op.m_msg.size()) ) {
+		// MPI defers the deallocation of the derived type until the
+		// pending send completed, so 'big' may leave scope right away
+		big.reset( op.m_msg.size(), dt );
+		dt = big.type();
+		count = 1;
+	}
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Isend(
+				const_cast<void*>(static_cast<const void*>(op.m_msg.addr())),
+				count, dt, op.m_rank, op.m_msg.tag(), m_comm, &req );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to post send towards rank '" << op.m_rank << "'" );
+	}
+	MPP_RECORD( 'i', op.m_rank, count, dt, op.m_msg.tag() );
+	set.add_raw( req, op.m_msg.type() );
+}
+
+template <class MsgType>
+inline void comm::post_one(request_set& set, irecv_op<MsgType>&& op) {
+	MPI_Datatype dt = op.m_msg.type();
+	int count = static_cast<int>(op.m_msg.size());
+	large_count_type big;
+	if ( !msg_impl<MsgType>::static_sized &&
+		 large_count_type::needed(op.m_msg.size()) ) {
+		big.reset( op.m_msg.size(), dt );
+		dt = big.type();
+		count = 1;
+	}
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Irecv(
+				const_cast<void*>(static_cast<const void*>(op.m_msg.addr())),
+				count, dt, op.m_rank, op.m_msg.tag(), m_comm, &req );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to post receive from rank '" << op.m_rank << "'" );
+	}
+	set.add_raw( req, op.m_msg.type() );
+}
+
+template <class... Ops>
+inline request_set comm::post(Ops&&... ops) {
+	// the communicator is validated once for the whole batch
+	check_init();
+	request_set set(*this);
+	set.reserve( sizeof...(Ops) );
+	// posts the descriptors left to right (pack expansion in a braced
+	// initializer guarantees the order)
+	int expand[] = { 0, ( post_one(set, std::move(ops)), 0 )... };
+	(void) expand;
+	return set;
+}
+
+} // end mpi namespace
@@ -0,0 +1,375 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/error.h"
+#include "detail/request.h"
+#include "detail/status.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <functional>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// progress_engine: an opt-in background thread which drives outstanding
+// nonblocking requests to completion (via MPI_Testsome) while the
+// application computes, enabling real communication/computation overlap
+// for large rendezvous messages. Requires the MPI environment to be
+// initialized with THREAD_MULTIPLE.
+//
+// Usage:
+// 		mpi::init(argc, argv, mpi::THREAD_MULTIPLE);
+// 		progress_engine::instance().start();
+// 		...
+// 		auto t = progress_engine::instance().submit( world(1) > msg(buf) );
+// 		compute();						// transfer progresses meanwhile
+// 		progress_engine::instance().wait(t);
+//
+// Completed tickets are published through a fixed-size lock-free ring (one
+// producer: the progress thread; one consumer: the application) and
+// additionally flagged on the ticket slot itself, so wait() never misses a
+// completion even when the ring is saturated
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class progress_engine {
+
+public:
+	typedef size_t ticket;
+
+private:
+	// completion state of a submitted request, filled in by the progress
+	// thread (slots live in a deque, hence stay put when new ones arrive).
+	// Slots are pooled: wait()/release() hand them back to a freelist, so
+	// sustained traffic recycles the same cache-line-aligned storage and
+	// steady-state submissions touch no allocator. A generation counter
+	// guards against stale tickets addressing a recycled slot
+	struct alignas(64) slot {
+		ticket				id;
+		size_t 				gen;
+		std::atomic<bool> 	done;
+		bool 				fire_and_forget;	// no ticket outstanding: the
+												// slot is recycled right
+												// after the continuation
+		MPI_Status 			stat;
+		MPI_Datatype		type;
+
+		// optional continuation, fired on the progress thread right
+		// before the completion is flagged (see request<T>::then)
+		std::function<void(const status&)> cont;
+
+		slot(ticket t, const MPI_Datatype& dt) :
+			id(t), gen(0), done(false), fire_and_forget(false), type(dt) { }
+	};
+
+	// a ticket packs the slot index (low half) and its generation at
+	// submission time (high half)
+	static const size_t ticket_shift = 32;
+
+	static inline ticket make_ticket(size_t idx, size_t gen) {
+		return idx | (gen << ticket_shift);
+	}
+	static inline size_t ticket_index(ticket t) {
+		return t & ((size_t(1) << ticket_shift) - 1);
+	}
+	static inline size_t ticket_gen(ticket t) {
+		return t >> ticket_shift;
+	}
+
+	static const size_t ring_size = 1024;	// power of two
+
+	std::thread 				m_thread;
+	std::atomic<bool> 			m_running;
+
+	// newly submitted requests, handed over to the progress thread
+	std::mutex 					m_mutex;
+	std::vector<MPI_Request> 	m_incoming_reqs;
+	std::vector<slot*> 			m_incoming_slots;
+
+	std::deque<slot> 			m_slots;
+	std::vector<size_t> 		m_free;		// indices of recyclable slots
+
+	// lock-free SPSC ring publishing completed tickets
+	std::vector<ticket> 		m_ring;
+	std::atomic<size_t> 		m_head;		// written by the progress thread
+	std::atomic<size_t> 		m_tail;		// written by the application
+
+	progress_engine() :
+		m_running(false), m_ring(ring_size), m_head(0), m_tail(0) { }
+
+	~progress_engine() { stop(); }
+
+	// Make this class non-copyable
+	progress_engine(const progress_engine& other) = delete;
+	progress_engine& operator=(const progress_engine& other) = delete;
+
+	// Picks a recycled slot from the freelist (or grows the arena when none
+	// is available) and primes it for a new submission. The caller must
+	// hold m_mutex
+	slot* acquire(const MPI_Datatype& dt, ticket& out) {
+		size_t idx;
+		if ( !m_free.empty() ) {
+			idx = m_free.back();
+			m_free.pop_back();
+		} else {
+			m_slots.emplace_back( 0, dt );
+			idx = m_slots.size()-1;
+		}
+		slot& s = m_slots[idx];
+		s.done.store(false, std::memory_order_relaxed);
+		s.fire_and_forget = false;
+		s.type = dt;
+		s.cont = nullptr;
+		out = make_ticket(idx, s.gen);
+		s.id = out;
+		return &s;
+	}
+
+	void publish(ticket t) {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (head - m_tail.load(std::memory_order_acquire) < ring_size) {
+			m_ring[head & (ring_size-1)] = t;
+			m_head.store(head+1, std::memory_order_release);
+		}
+		// if the ring is full the completion is only visible through the
+		// slot flag, which wait()/test() check anyway
+	}
+
+	// body of the progress thread: absorb new submissions, test the active
+	// ones, flag and publish completions
+	void run() {
+		std::vector<MPI_Request> 	active;
+		std::vector<slot*> 			slots;
+		std::vector<int> 			indices;
+		std::vector<MPI_Status> 	statuses;
+
+		while( m_running.load(std::memory_order_acquire) ) {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for(size_t i=0; i<m_incoming_reqs.size(); ++i) {
+					active.push_back( m_incoming_reqs[i] );
+					slots.push_back( m_incoming_slots[i] );
+				}
+				m_incoming_reqs.resize(0);
+				m_incoming_slots.resize(0);
+			}
+
+			if ( active.empty() ) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			indices.resize( active.size() );
+			statuses.resize( active.size() );
+
+			int outcount = 0;
+			MPI_Testsome( static_cast<int>(active.size()), &active.front(),
+						  &outcount, &indices.front(), &statuses.front() );
+
+			if (outcount == MPI_UNDEFINED || outcount == 0) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			for(int i=0; i<outcount; ++i) {
+				slot* s = slots[ indices[i] ];
+				s->stat = statuses[i];
+				// detached submissions (request<T>::then) hand out no
+				// ticket: move the continuation out, recycle the slot and
+				// fire - nothing is flagged or published for them, the
+				// arena stays bounded
+				if ( s->fire_and_forget ) {
+					std::function<void(const status&)> cont =
+						std::move(s->cont);
+					MPI_Datatype type = s->type;
+					release( s->id );
+					cont( status(comm::world, statuses[i], type) );
+					continue;
+				}
+				// the continuation must fire before the done flag is
+				// raised: once the application observes the flag it may
+				// release the slot back to the pool
+				if ( s->cont ) {
+					s->cont( status(comm::world, s->stat, s->type) );
+				}
+				ticket id = s->id;
+				s->done.store(true, std::memory_order_release);
+				publish( id );
+			}
+
+			// compact the arrays, dropping the completed entries
+			size_t keep = 0;
+			for(size_t i=0; i<active.size(); ++i) {
+				if (active[i] != MPI_REQUEST_NULL) {
+					active[keep] = active[i];
+					slots[keep] = slots[i];
+					++keep;
+				}
+			}
+			active.resize(keep);
+			slots.resize(keep);
+		}
+	}
+
+public:
+
+	static progress_engine& instance() {
+		static progress_engine engine;
+		return engine;
+	}
+
+	// Starts the background progress thread. The MPI library must provide
+	// THREAD_MULTIPLE, as the engine calls into MPI concurrently with the
+	// application
+	void start() {
+		if ( m_running.load() ) { return; }
+
+		int provided;
+		MPI_Query_thread(&provided);
+		if (provided < MPI_THREAD_MULTIPLE) {
+			MPP_REPORT_ERROR( MPI_ERR_OTHER,
+				"The progress engine requires THREAD_MULTIPLE, but the MPI "
+				"library only provides thread level '" << provided << "'" );
+			return;
+		}
+
+		m_running.store(true);
+		m_thread = std::thread(&progress_engine::run, this);
+	}
+
+	// Stops and joins the progress thread (invoked by mpi::finalize()).
+	// Requests still in flight are left untouched
+	void stop() {
+		if ( !m_running.load() ) { return; }
+		m_running.store(false);
+		m_thread.join();
+	}
+
+	// Hands a pending request over to the engine, which will drive it to
+	// completion in the background. Returns the ticket to wait on
+	template <class T>
+	ticket submit(request<T>&& req) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		ticket t;
+		slot* s = acquire( req.m_msg.type(), t );
+		m_incoming_reqs.push_back( req.m_req );
+		m_incoming_slots.push_back( s );
+		req.m_req = MPI_REQUEST_NULL;
+		req.done = 1;
+		return t;
+	}
+
+	// As above, additionally registering a continuation invoked (on the
+	// progress thread) with the completion status
+	template <class T, class Functor>
+	ticket submit(request<T>&& req, Functor&& f) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		ticket t;
+		slot* s = acquire( req.m_msg.type(), t );
+		s->cont = std::forward<Functor>(f);
+		m_incoming_reqs.push_back( req.m_req );
+		m_incoming_slots.push_back( s );
+		req.m_req = MPI_REQUEST_NULL;
+		req.done = 1;
+		return t;
+	}
+
+	// Detached variant used by request<T>::then(): no ticket is handed
+	// out, the slot is recycled by the engine right after the continuation
+	// fired, so fire-and-forget pipelines do not grow the arena
+	template <class T, class Functor>
+	void submit_detached(request<T>&& req, Functor&& f) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		ticket t;
+		slot* s = acquire( req.m_msg.type(), t );
+		s->cont = std::forward<Functor>(f);
+		s->fire_and_forget = true;
+		m_incoming_reqs.push_back( req.m_req );
+		m_incoming_slots.push_back( s );
+		req.m_req = MPI_REQUEST_NULL;
+		req.done = 1;
+	}
+
+	// Tests (without blocking) whether the given ticket completed
+	inline bool test(ticket t) {
+		const slot& s = m_slots[ ticket_index(t) ];
+		// a recycled slot implies the original submission completed long ago
+		return s.gen != ticket_gen(t)
+			|| s.done.load(std::memory_order_acquire);
+	}
+
+	// Waits for the completion of the given ticket; the transfer itself is
+	// progressed by the engine thread. The ticket is consumed: its slot is
+	// handed back to the pool for later submissions to reuse
+	inline status wait(ticket t, const comm& com = comm::world) {
+		while( !test(t) ) { std::this_thread::yield(); }
+		slot& s = m_slots[ ticket_index(t) ];
+		status res(com, s.stat, s.type);
+		release(t);
+		return res;
+	}
+
+	// Returns a completed slot to the pool. wait() releases automatically;
+	// poll()-based consumers invoke this once they are done with a ticket.
+	// Releasing a ticket twice is harmless
+	inline void release(ticket t) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		slot& s = m_slots[ ticket_index(t) ];
+		if ( s.gen != ticket_gen(t) ) { return; }
+		++s.gen;
+		m_free.push_back( ticket_index(t) );
+	}
+
+	// Number of slots ever carved from the arena: under steady-state
+	// traffic this settles at the peak number of in-flight requests
+	inline size_t arena_size() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_slots.size();
+	}
+
+	// Drains the completion ring, invoking the given functor with each
+	// newly completed ticket
+	template <class Functor>
+	inline void poll(const Functor& f) {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		while( tail != m_head.load(std::memory_order_acquire) ) {
+			f( m_ring[tail & (ring_size-1)] );
+			++tail;
+		}
+		m_tail.store(tail, std::memory_order_release);
+	}
+
+};
+
+template <class T>
+template <class Functor>
+inline void request<T>::then(Functor&& f) {
+	progress_engine::instance().submit_detached( std::move(*this),
+												 std::forward<Functor>(f) );
+}
+
+} // end mpi namespace
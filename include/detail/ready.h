@@ -0,0 +1,228 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/endpoint.h"
+#include "detail/status.h"
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Ready-mode transfers with a built-in correctness handshake. MPI_Rsend
+// skips the eager/rendezvous negotiation entirely - the lowest-latency
+// path there is - but is only legal when the matching receive is already
+// posted, which nothing in the plain rsend wrapper helps guarantee. The
+// ready_sender/ready_receiver pair makes that guarantee structural:
+//
+// 		receiver:	auto rx = comm::world(peer).rrecv_init( msg(in) );
+// 					rx.arm();			// pre-post + certify readiness
+// 					... 				// sender may fire from here on
+// 					rx.wait();
+//
+// 		sender:		auto tx = comm::world(peer).rsend_init( msg(out) );
+// 					tx.send();			// blocks on the certificate, then
+// 										// MPI_Rsend with zero protocol cost
+//
+// arm() starts a persistent receive (MPI_Recv_init) and only then emits a
+// zero-byte readiness certificate on a reserved tag; send() consumes one
+// certificate per message before firing the persistent ready-send, so an
+// rsend can never overtake its receive. Steady-state cost per message:
+// one zero-byte certificate plus the raw rsend
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// tag reserved for the readiness certificates; keep user traffic off it
+static const int ready_tag = 28657;
+
+template <class T>
+class ready_sender {
+
+	const comm& 	m_comm;
+	msg_impl<T>		m_msg;
+	MPI_Datatype	m_type;
+	MPI_Request 	m_req;		// persistent MPI_Rsend_init
+	MPI_Status		m_status;
+	int 			m_peer;
+
+	ready_sender(const comm& com, MPI_Request req, msg_impl<T>&& msg,
+				 const MPI_Datatype& dt, int peer):
+		m_comm(com), m_msg(std::move(msg)), m_type(dt), m_req(req),
+		m_peer(peer) { }
+
+	// Make this class non-copyable
+	ready_sender(const ready_sender<T>& other) = delete;
+	ready_sender<T>& operator=(const ready_sender<T>& other) = delete;
+
+	friend class endpoint;
+
+public:
+	ready_sender(ready_sender<T>&& other) :
+		m_comm( other.m_comm ),
+		m_msg( std::move(other.m_msg) ),
+		m_type( other.m_type ),
+		m_req( other.m_req ),
+		m_status( other.m_status ),
+		m_peer( other.m_peer )
+	{
+		other.m_req = MPI_REQUEST_NULL;
+	}
+
+	~ready_sender() {
+		if (m_req != MPI_REQUEST_NULL) { MPI_Request_free(&m_req); }
+	}
+
+	// Consumes one readiness certificate from the receiver (blocking until
+	// it arrives), then fires the persistent ready-send
+	inline status send() {
+		int err = MPI_Recv( NULL, 0, MPI_BYTE, m_peer, ready_tag,
+							m_comm.mpi_comm(), MPI_STATUS_IGNORE );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err,
+				"Failed to receive readiness certificate from rank '"
+					<< m_peer << "'" );
+		}
+		err = MPI_Start( &m_req );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to start ready-mode send" );
+		}
+		MPI_Wait( &m_req, &m_status );
+		return status(m_comm, m_status, m_type);
+	}
+
+};
+
+template <class T>
+class ready_receiver {
+
+	const comm& 	m_comm;
+	msg_impl<T>		m_msg;
+	MPI_Datatype	m_type;
+	MPI_Request 	m_req;		// persistent MPI_Recv_init
+	MPI_Status		m_status;
+	int 			m_peer;
+
+	ready_receiver(const comm& com, MPI_Request req, msg_impl<T>&& msg,
+				   const MPI_Datatype& dt, int peer):
+		m_comm(com), m_msg(std::move(msg)), m_type(dt), m_req(req),
+		m_peer(peer) { }
+
+	// Make this class non-copyable
+	ready_receiver(const ready_receiver<T>& other) = delete;
+	ready_receiver<T>& operator=(const ready_receiver<T>& other) = delete;
+
+	friend class endpoint;
+
+public:
+	ready_receiver(ready_receiver<T>&& other) :
+		m_comm( other.m_comm ),
+		m_msg( std::move(other.m_msg) ),
+		m_type( other.m_type ),
+		m_req( other.m_req ),
+		m_status( other.m_status ),
+		m_peer( other.m_peer )
+	{
+		other.m_req = MPI_REQUEST_NULL;
+	}
+
+	~ready_receiver() {
+		if (m_req != MPI_REQUEST_NULL) { MPI_Request_free(&m_req); }
+	}
+
+	// Pre-posts the receive (MPI_Start) and only then certifies readiness
+	// to the sender, so the certificate can never precede the posting
+	inline ready_receiver<T>& arm() {
+		int err = MPI_Start( &m_req );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to pre-post ready-mode receive" );
+			return *this;
+		}
+		err = MPI_Send( NULL, 0, MPI_BYTE, m_peer, ready_tag,
+						m_comm.mpi_comm() );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err,
+				"Failed to send readiness certificate to rank '"
+					<< m_peer << "'" );
+		}
+		return *this;
+	}
+
+	// Waits for the pre-posted receive to complete; the pairing stays
+	// valid and can be armed again
+	inline status wait() {
+		MPI_Wait( &m_req, &m_status );
+		return status(m_comm, m_status, m_type);
+	}
+
+	// Tests (without blocking) the completion of the current iteration
+	inline bool test() {
+		int flag;
+		MPI_Test( &m_req, &flag, &m_status );
+		return flag != 0;
+	}
+
+};
+
+// Creates a persistent ready-mode send towards this endpoint
+// (MPI_Rsend_init); fire it with ready_sender::send()
+template <class MsgType>
+inline ready_sender<MsgType> endpoint::rsend_init(msg_impl<MsgType>&& m) {
+	MPI_Datatype&& dt = m.type();
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Rsend_init( const_cast<void*>(static_cast<const void*>(m.addr())),
+						static_cast<int>(m.size()), dt,
+						m_rank,
+						m.tag(),
+						m_comm.mpi_comm(),
+						&req
+					  );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to create ready-mode send channel to rank '"
+			<< m_rank << "'" );
+	}
+	return ready_sender<MsgType>(m_comm, req, std::move(m), dt, m_rank);
+}
+
+// Creates the matching pre-posted receive side (MPI_Recv_init); arm it
+// before the sender fires
+template <class MsgType>
+inline ready_receiver<MsgType> endpoint::rrecv_init(msg_impl<MsgType>&& m) {
+	MPI_Datatype&& dt = m.type();
+	MPI_Request req = MPI_REQUEST_NULL;
+	int err = MPI_Recv_init( static_cast<void*>(m.addr()),
+						static_cast<int>(m.size()), dt,
+						m_rank,
+						m.tag(),
+						m_comm.mpi_comm(),
+						&req
+					  );
+	if ( err != MPI_SUCCESS ) {
+		MPP_REPORT_ERROR( err,
+			"Failed to create ready-mode recv channel from rank '"
+			<< m_rank << "'" );
+	}
+	return ready_receiver<MsgType>(m_comm, req, std::move(m), dt, m_rank);
+}
+
+} // end mpi namespace
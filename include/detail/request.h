@@ -26,6 +26,14 @@
 
 #include "detail/status.h"
 
+#if defined(__cpp_impl_coroutine)
+	#include <version>
+	#if defined(__cpp_lib_coroutine)
+		#define MPP_HAS_COROUTINES 1
+		#include <coroutine>
+	#endif
+#endif
+
 namespace mpi {
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -37,48 +45,82 @@ class request{
 	const comm&     			m_comm;
 	MPI_Request 				m_req;
 	msg_impl<T>					m_msg;
-	std::unique_ptr<status> 	m_status;
+	MPI_Status					m_status;	// filled in upon completion,
+											// kept inline to avoid any
+											// allocation on the poll path
 	int 		 				done;
 
 public:
 	request(const comm& com, MPI_Request req, msg_impl<T>&& msg):
 		m_comm(com), m_req(req), m_msg(std::move(msg)), done(0) { }
 
-	request(request<T>&& other) : 
-		m_comm( std::move(other.m_comm) ), 
-		m_req( std::move(other.m_req) ), 
+	request(request<T>&& other) :
+		m_comm( std::move(other.m_comm) ),
+		m_req( std::move(other.m_req) ),
 		m_msg( std::move(other.m_msg) ),
-		m_status( std::move(other.m_status) ),
+		m_status( other.m_status ),
 		done(other.done) { }
 
 	void cancel();
 
 	inline const T& get() {
 		if ( !done ) {
-			status::mpi_status_ptr stat(new MPI_Status);
 			// wait to receive the message
-			MPI_Wait(&m_req, stat.get());
+			MPI_Wait(&m_req, &m_status);
 			done = 1;
-			m_status.reset( new status(m_comm, std::move(stat), m_msg.type()) );
 		}
 		return m_msg.get();
 	}
 
 	inline status getStatus() {
-		if( isDone() ) { return *m_status; }
+		if( isDone() ) { return status(m_comm, m_status, m_msg.type()); }
 		throw "not done";
 	}
 
 	inline bool isDone() {
 		if ( !done ) {
-			status::mpi_status_ptr stat(new MPI_Status);
-			MPI_Test(&m_req, &done, stat.get());
-			if ( done ) {
-				m_status.reset( new status(m_comm, std::move(stat), m_msg.type()) );
-			}
+			MPI_Test(&m_req, &done, &m_status);
 		}
 		return done;
 	}
+
+	/**
+	 * Registers a continuation fired when this request completes (invoked
+	 * on the progress thread, which must be running - see progress.h,
+	 * where this member is defined). The pending transfer is handed over
+	 * to the engine; the message buffer remains property of the caller
+	 */
+	template <class Functor>
+	inline void then(Functor&& f);
+
+#if defined(MPP_HAS_COROUTINES)
+	/**
+	 * Awaitable support: co_await suspends the coroutine and resumes it
+	 * (from the progress thread) once the transfer completed, evaluating
+	 * to a reference to the received data
+	 */
+	struct awaiter {
+		request<T>& req;
+
+		bool await_ready() { return req.isDone(); }
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			req.then( [handle](const status&) mutable { handle.resume(); } );
+		}
+
+		const T& await_resume() { return req.get(); }
+	};
+
+	inline awaiter operator co_await() { return awaiter{*this}; }
+#endif
+
+	/**
+	 * The request_set and the progress_engine extract the raw MPI_Request
+	 * handle in order to drive batches of requests to completion on the
+	 * caller's behalf
+	 */
+	friend class request_set;
+	friend class progress_engine;
 };
 
 } // end mpi namespace 
@@ -0,0 +1,206 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/request.h"
+
+#include <vector>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// request_set: type-erases a group of request<T> objects (possibly wrapping
+// messages of different types) into a contiguous MPI_Request array so that
+// their completion can be driven by the batched MPI primitives (MPI_Waitall/
+// Waitany/Waitsome) instead of testing each request individually. The status
+// and index arrays are members reused across calls, hence driving a whole
+// exchange to completion performs no per-poll allocation.
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class request_set {
+
+	const comm& 				m_comm;
+	std::vector<MPI_Request> 	m_reqs;
+	std::vector<MPI_Datatype>	m_types;
+	std::vector<MPI_Status> 	m_statuses;
+	std::vector<MPI_Status> 	m_scratch;
+	std::vector<int> 			m_indices;
+
+	// Make this class non-copyable
+	request_set(const request_set& other) = delete;
+	request_set& operator=(const request_set& other) = delete;
+
+	// comm::post() writes freshly posted handles straight into the
+	// contiguous array, bypassing the request<T> detour (see post.h)
+	inline size_t add_raw(MPI_Request req, const MPI_Datatype& dt) {
+		m_reqs.push_back( req );
+		m_types.push_back( dt );
+		return m_reqs.size()-1;
+	}
+
+	friend class comm;
+
+public:
+	request_set(const comm& com = comm::world) : m_comm(com) { }
+
+	request_set(request_set&& other) :
+		m_comm( other.m_comm ),
+		m_reqs( std::move(other.m_reqs) ),
+		m_types( std::move(other.m_types) ),
+		m_statuses( std::move(other.m_statuses) ),
+		m_indices( std::move(other.m_indices) ) { }
+
+	// Absorbs a pending request into this set and returns the index under
+	// which its completion status can be queried later on. The ownership of
+	// the MPI_Request handle is transferred to the set, the message buffer
+	// remains (as always) property of the caller
+	template <class T>
+	inline size_t add(request<T>&& req) {
+		m_reqs.push_back( req.m_req );
+		m_types.push_back( req.m_msg.type() );
+		req.m_req = MPI_REQUEST_NULL;
+		req.done = 1;
+		return m_reqs.size()-1;
+	}
+
+	inline size_t size() const { return m_reqs.size(); }
+
+	// Pre-sizes the handle arrays, so posting a batch of known size never
+	// reallocates midway
+	inline void reserve(size_t n) {
+		m_reqs.reserve(n);
+		m_types.reserve(n);
+	}
+
+	// Waits for the completion of every request of the set (MPI_Waitall)
+	inline void wait_all() {
+		m_statuses.resize( m_reqs.size() );
+		m_scratch.resize( m_reqs.size() );
+		// remember which requests are still active: statuses recorded by
+		// previous wait_any/wait_some calls must not be clobbered by the
+		// empty statuses MPI_Waitall reports for inactive handles
+		m_indices.resize( 0 );
+		for(size_t idx = 0; idx < m_reqs.size(); ++idx) {
+			if (m_reqs[idx] != MPI_REQUEST_NULL) {
+				m_indices.push_back( static_cast<int>(idx) );
+			}
+		}
+		int err = MPI_Waitall( static_cast<int>(m_reqs.size()),
+							   &m_reqs.front(),
+							   &m_scratch.front() );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to wait for the completion of "
+							  << m_reqs.size() << " requests" );
+		}
+		for(int idx : m_indices) { m_statuses[idx] = m_scratch[idx]; }
+	}
+
+	// Waits until (at least) one of the requests completes and returns its
+	// index (MPI_Waitany). If the set contains no active request, the size
+	// of the set is returned
+	inline size_t wait_any() {
+		m_statuses.resize( m_reqs.size() );
+		int index;
+		MPI_Status stat;
+		int err = MPI_Waitany( static_cast<int>(m_reqs.size()),
+							   &m_reqs.front(),
+							   &index,
+							   &stat );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to wait for the completion of any of "
+							  << m_reqs.size() << " requests" );
+			return m_reqs.size();
+		}
+		if (index == MPI_UNDEFINED) { return m_reqs.size(); }
+		m_statuses[index] = stat;
+		return static_cast<size_t>(index);
+	}
+
+	// Waits until at least one of the requests completes and returns the
+	// indices of all the completed ones (MPI_Waitsome)
+	inline const std::vector<int>& wait_some() {
+		m_statuses.resize( m_reqs.size() );
+		m_scratch.resize( m_reqs.size() );
+		m_indices.resize( m_reqs.size() );
+		int outcount;
+		int err = MPI_Waitsome( static_cast<int>(m_reqs.size()),
+								&m_reqs.front(),
+								&outcount,
+								&m_indices.front(),
+								&m_scratch.front() );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to wait for the completion of some of "
+							  << m_reqs.size() << " requests" );
+			m_indices.resize( 0 );
+			return m_indices;
+		}
+		m_indices.resize( outcount == MPI_UNDEFINED ? 0 : outcount );
+		// the statuses returned by MPI_Waitsome are packed at the front of
+		// the scratch array (in no guaranteed index order), scatter them
+		// back to their request index
+		for(size_t idx = 0; idx < m_indices.size(); ++idx) {
+			m_statuses[ m_indices[idx] ] = m_scratch[idx];
+		}
+		return m_indices;
+	}
+
+	// Tests (without blocking) whether every request of the set completed
+	inline bool test_all() {
+		m_statuses.resize( m_reqs.size() );
+		m_scratch.resize( m_reqs.size() );
+		// as in wait_all(): only copy back the statuses of the requests
+		// which were still active, the empty statuses reported for the
+		// inactive handles must not clobber the recorded ones
+		m_indices.resize( 0 );
+		for(size_t idx = 0; idx < m_reqs.size(); ++idx) {
+			if (m_reqs[idx] != MPI_REQUEST_NULL) {
+				m_indices.push_back( static_cast<int>(idx) );
+			}
+		}
+		int flag;
+		int err = MPI_Testall( static_cast<int>(m_reqs.size()),
+							   &m_reqs.front(),
+							   &flag,
+							   &m_scratch.front() );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to test for the completion of "
+							  << m_reqs.size() << " requests" );
+			return false;
+		}
+		if (flag != 0) {
+			for(int idx : m_indices) { m_statuses[idx] = m_scratch[idx]; }
+		}
+		return flag != 0;
+	}
+
+	// Returns the status of the (already completed) request added under the
+	// given index
+	inline status status_of(size_t index) {
+		assert( index < m_statuses.size() && "Request not completed yet" );
+		return status(m_comm, m_statuses[index], m_types[index]);
+	}
+
+};
+
+} // end mpi namespace
@@ -0,0 +1,161 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/error.h"
+#include "detail/comm.h"
+#include "detail/type_traits.h"
+
+#include <cstring>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// shared_window<T>: the intra-node fast path. Allocates one segment of
+// 'count' elements per rank of a node-local communicator (typically
+// comm::node()) through MPI_Win_allocate_shared, and resolves a direct
+// pointer to every peer's segment (MPI_Win_shared_query), so node-local
+// transfers degenerate to a plain memcpy/load/store with no MPI matching
+// at all:
+//
+// 		shared_window<double> win(1024);		// on comm::node()
+// 		win.put( peer, v );						// memcpy into peer's segment
+// 		win.sync();								// make the writes visible
+//
+// A passive-target epoch (lock_all with NOCHECK) is held open for the
+// lifetime of the window, as required for direct load/store access;
+// sync() pairs MPI_Win_sync with a barrier on the node communicator
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class T>
+class shared_window {
+
+	const comm& 	m_comm;
+	MPI_Win 		m_win;
+	int 			m_rank;		// this rank within the node communicator
+	size_t 			m_count;
+	std::vector<T*> m_peers;	// direct pointers into every local rank's
+								// segment, indexed by node-comm rank
+
+	// Make this class non-copyable
+	shared_window(const shared_window<T>& other) = delete;
+	shared_window<T>& operator=(const shared_window<T>& other) = delete;
+
+public:
+	// Collectively allocates 'count' elements per rank of the given
+	// node-local communicator
+	shared_window(size_t count, const comm& com = comm::node()) :
+		m_comm(com), m_win(MPI_WIN_NULL), m_rank(-1), m_count(count)
+	{
+		MPI_Comm_rank( com.mpi_comm(), &m_rank );
+
+		T* base = NULL;
+		int err = MPI_Win_allocate_shared(
+				static_cast<MPI_Aint>( count * sizeof(T) ),
+				static_cast<int>( sizeof(T) ),
+				MPI_INFO_NULL, com.mpi_comm(), &base, &m_win );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to allocate shared-memory window" );
+			return;
+		}
+
+		int nranks;
+		MPI_Comm_size( com.mpi_comm(), &nranks );
+		m_peers.resize( nranks );
+		for(int r=0; r<nranks; ++r) {
+			MPI_Aint size;
+			int disp_unit;
+			MPI_Win_shared_query( m_win, r, &size, &disp_unit, &m_peers[r] );
+		}
+
+		// direct load/store requires an open access epoch; no conflicting
+		// locks can exist, hence NOCHECK
+		MPI_Win_lock_all( MPI_MODE_NOCHECK, m_win );
+	}
+
+	shared_window(shared_window<T>&& other) :
+		m_comm( other.m_comm ),
+		m_win( other.m_win ),
+		m_rank( other.m_rank ),
+		m_count( other.m_count ),
+		m_peers( std::move(other.m_peers) )
+	{
+		other.m_win = MPI_WIN_NULL;
+	}
+
+	// Frees the window and its segments (collective, like the allocation)
+	~shared_window() {
+		if ( m_win == MPI_WIN_NULL ) { return; }
+		MPI_Win_unlock_all( m_win );
+		MPI_Win_free( &m_win );
+	}
+
+	// Direct access to this rank's own segment
+	inline T* local() { return m_peers[m_rank]; }
+
+	// Direct access to the segment of the given node-comm rank
+	inline T* operator[](int rank) {
+		assert( static_cast<size_t>(rank) < m_peers.size() &&
+				"Rank outside the node communicator" );
+		return m_peers[rank];
+	}
+
+	// Copies a contiguous payload straight into the segment of the given
+	// rank, starting at the given element offset
+	template <class MsgType>
+	inline shared_window<T>& put(int rank, const MsgType& v, size_t offset = 0) {
+		size_t n = mpi_type_traits<const MsgType>::get_size(v);
+		assert( offset + n <= m_count && "Payload overruns the segment" );
+		std::memcpy( (*this)[rank] + offset,
+					 mpi_type_traits<const MsgType>::get_addr(v),
+					 n * sizeof(T) );
+		return *this;
+	}
+
+	// Copies from the segment of the given rank into a contiguous payload
+	template <class MsgType>
+	inline shared_window<T>& get(int rank, MsgType& v, size_t offset = 0) {
+		size_t n = mpi_type_traits<MsgType>::get_size(v);
+		assert( offset + n <= m_count && "Payload overruns the segment" );
+		std::memcpy( mpi_type_traits<MsgType>::get_addr(v),
+					 (*this)[rank] + offset,
+					 n * sizeof(T) );
+		return *this;
+	}
+
+	// Makes all writes to the shared segments visible to the other local
+	// ranks (memory sync on both sides of a node barrier)
+	inline void sync() {
+		MPI_Win_sync( m_win );
+		MPI_Barrier( m_comm.mpi_comm() );
+		MPI_Win_sync( m_win );
+	}
+
+	inline size_t size() const { return m_count; }
+
+	inline const comm& get_comm() const { return m_comm; }
+
+};
+
+} // end mpi namespace
@@ -0,0 +1,156 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include <ostream>
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Hot-path instrumentation, enabled by compiling with -DMPP_INSTRUMENT.
+// The point-to-point paths (endpoint::send_impl, isend, operator>>) are
+// annotated with the two macros below; compiled out they expand to
+// nothing, compiled in they maintain per-peer counters (messages, bytes,
+// cumulative wall time, max latency) in cache-line-padded slots plus a
+// fixed-size ring of trace events, all thread-local so the hot path takes
+// no lock. Read the counters with mpi::stats::snapshot(), dump the trace
+// per rank with mpi::stats::dump_trace(os)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#if defined(MPP_INSTRUMENT)
+
+namespace mpi { namespace stats {
+
+// per-peer counter slot; padded to a cache line so neighboring peers do
+// not false-share when snapshots are taken concurrently
+struct alignas(64) counters {
+	unsigned long long 	messages;
+	unsigned long long 	bytes;
+	double 				total_time;		// seconds spent in the MPI calls
+	double 				max_latency;	// slowest single call, seconds
+
+	counters() : messages(0), bytes(0), total_time(0.0), max_latency(0.0) { }
+};
+
+// one entry of the event trace ring
+struct event {
+	double 				time;	// MPI_Wtime at completion
+	int 				peer;
+	int 				tag;
+	unsigned long long 	bytes;
+	char 				kind;	// 's'end / 'i'send / 'r'ecv
+};
+
+class registry {
+
+	static const size_t trace_size = 4096;
+
+	std::vector<counters> 	m_slots;	// indexed by peer rank
+	std::vector<event> 		m_trace;
+	size_t 					m_head;		// total events ever recorded
+
+public:
+	registry() : m_trace(trace_size), m_head(0) { }
+
+	static registry& instance() {
+		static thread_local registry reg;
+		return reg;
+	}
+
+	inline void record(char kind, int peer, int tag,
+					   unsigned long long bytes, double elapsed) {
+		if ( m_slots.size() <= static_cast<size_t>(peer) ) {
+			m_slots.resize( peer+1 );
+		}
+		counters& c = m_slots[peer];
+		++c.messages;
+		c.bytes += bytes;
+		c.total_time += elapsed;
+		if ( elapsed > c.max_latency ) { c.max_latency = elapsed; }
+
+		event& e = m_trace[ m_head++ % trace_size ];
+		e.time = MPI_Wtime();
+		e.peer = peer;
+		e.tag = tag;
+		e.bytes = bytes;
+		e.kind = kind;
+	}
+
+	inline const std::vector<counters>& slots() const { return m_slots; }
+
+	// Writes the retained trace events (oldest first) as one line each:
+	// time kind peer tag bytes
+	inline void dump(std::ostream& os) const {
+		size_t count = m_head < trace_size ? m_head : trace_size;
+		size_t first = m_head - count;
+		for(size_t i=0; i<count; ++i) {
+			const event& e = m_trace[ (first+i) % trace_size ];
+			os << e.time << " " << e.kind << " " << e.peer << " "
+			   << e.tag << " " << e.bytes << "\n";
+		}
+	}
+
+	inline void reset() {
+		m_slots.clear();
+		m_head = 0;
+	}
+};
+
+inline void record(char kind, int peer, int tag,
+				   unsigned long long bytes, double elapsed) {
+	registry::instance().record(kind, peer, tag, bytes, elapsed);
+}
+
+// A copy of the per-peer counters of this thread, indexed by peer rank
+inline std::vector<counters> snapshot() {
+	return registry::instance().slots();
+}
+
+inline void dump_trace(std::ostream& os) {
+	registry::instance().dump(os);
+}
+
+inline void reset() {
+	registry::instance().reset();
+}
+
+} } // end mpi::stats namespace
+
+#define MPP_TIMER_START() const double _mpp_t0 = MPI_Wtime()
+
+#define MPP_RECORD(Kind, Rank, Count, Dt, Tag) \
+	do { \
+		int _mpp_tsize; \
+		MPI_Type_size( (Dt), &_mpp_tsize ); \
+		mpi::stats::record( (Kind), (Rank), (Tag), \
+			static_cast<unsigned long long>(Count) * _mpp_tsize, \
+			MPI_Wtime() - _mpp_t0 ); \
+	} while(0)
+
+#else
+
+// compiled out: not a single instruction on the hot path
+#define MPP_TIMER_START() 					do { } while(0)
+#define MPP_RECORD(Kind, Rank, Count, Dt, Tag) 	do { } while(0)
+
+#endif // MPP_INSTRUMENT
@@ -29,39 +29,47 @@
 
 #include "detail/decls.h"
 
-#include <memory>
-
 namespace mpi {
 
 struct status{
 
-	typedef std::unique_ptr<MPI_Status> mpi_status_ptr;
-
 	status(status&& other) :
-		m_comm(std::move(other.m_comm)), 
-		m_status(std::move(other.m_status)),
+		m_comm(std::move(other.m_comm)),
+		m_status(other.m_status),
 		m_datatype(other.m_datatype) { }
 
 	inline endpoint source();
 
 	inline int count() const {
 		int count;
-		MPI_Get_count(m_status.get(), m_datatype, &count);
+		MPI_Get_count(&m_status, m_datatype, &count);
 		return count;
 	}
 
 	inline int tag() const {
-		return m_status->MPI_TAG;
+		return m_status.MPI_TAG;
 	}
 
 	inline int error() const {
-		return m_status->MPI_ERROR;
+		return m_status.MPI_ERROR;
 	}
 
 	/** 
 	 * Friend classes declarations 
 	 */
 	friend class endpoint;
+	friend class request_set;
+	friend class progress_engine;
+	friend class dispatcher;
+
+	template <class T>
+	friend class channel;
+
+	template <class T>
+	friend class ready_sender;
+
+	template <class T>
+	friend class ready_receiver;
 
 	template <class T>
 	friend class request;
@@ -73,16 +81,20 @@ private:
 	 * the MPP library and it would make no sense if the user could
 	 * automatically generate one of those 
 	 */
-	status(const comm& com, mpi_status_ptr&& s, const MPI_Datatype& dt):
-		m_comm(com), 
-		m_status(std::move(s)), 
+	/**
+	 * The MPI_Status is stored by value (it is a small POD): creating and
+	 * returning a status object therefore involves no heap allocation
+	 */
+	status(const comm& com, const MPI_Status& s, const MPI_Datatype& dt):
+		m_comm(com),
+		m_status(s),
 		m_datatype(dt) { }
 
 	status(const status& other) = delete;
 	status& operator=(const status& other) = delete;
 
 	const comm&      	m_comm;
-	mpi_status_ptr		m_status;
+	MPI_Status			m_status;
 	const MPI_Datatype  m_datatype;
 };
 
@@ -93,7 +105,7 @@ private:
 namespace mpi {
 
 inline endpoint status::source() {
-	return endpoint(m_status->MPI_SOURCE, m_comm);
+	return endpoint(m_status.MPI_SOURCE, m_comm);
 }
 
 
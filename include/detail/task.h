@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/request.h"
+
+#if defined(MPP_HAS_COROUTINES)
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// task: a minimal fire-and-forget coroutine type for communication
+// pipelines built with co_await on request<T>. The coroutine starts
+// eagerly, suspends whenever an awaited transfer is not complete yet (to
+// be resumed by the progress thread) and cleans itself up on completion:
+//
+// 		mpi::task stage(std::vector<double>& buf) {
+// 			co_await ( comm::world(prev) > msg(buf) );
+// 			transform(buf);
+// 			co_await comm::world(next).isend( msg(buf) );
+// 		}
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+struct task {
+
+	struct promise_type {
+		task get_return_object() { return task{}; }
+		std::suspend_never initial_suspend() { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() { }
+		void unhandled_exception() { std::terminate(); }
+	};
+
+};
+
+} // end mpi namespace
+
+#endif // MPP_HAS_COROUTINES
@@ -0,0 +1,219 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/comm.h"
+#include "detail/endpoint.h"
+#include "detail/message.h"
+#include "detail/request.h"
+
+#include <vector>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// cartesian_comm: a communicator with a cartesian topology attached
+// (MPI_Cart_create). The coordinates of this rank and the neighbor endpoint
+// in each direction are computed once at construction (MPI_Cart_shift),
+// so halo exchanges address their neighbors without re-deriving them on
+// every step. On the borders of a non-periodic dimension the neighbor is
+// MPI_PROC_NULL, to which sends/recvs are no-ops
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+class cartesian_comm : public comm {
+
+	std::vector<int> 		m_dims;
+	std::vector<int> 		m_coords;
+	std::vector<endpoint> 	m_neighbors;	// 2 entries per dimension:
+											// [2*dim] = minus, [2*dim+1] = plus
+
+	// halo pattern registered via set_halo(): per-neighbor block sizes and
+	// the matching displacements into the packed buffers, cached so each
+	// exchange step boils down to a single MPI call
+	std::vector<int> 		m_send_counts;
+	std::vector<int> 		m_recv_counts;
+	std::vector<int> 		m_send_displs;
+	std::vector<int> 		m_recv_displs;
+
+	// Neighbor endpoints hold references to this object, hence it can
+	// neither be copied nor moved
+	cartesian_comm(const cartesian_comm& other) = delete;
+	cartesian_comm& operator=(const cartesian_comm& other) = delete;
+	cartesian_comm(cartesian_comm&& other) = delete;
+
+	static MPI_Comm create(const comm& parent, const std::vector<int>& dims,
+						   const std::vector<int>& periods, bool reorder)
+	{
+		assert( dims.size() == periods.size() &&
+				"One periodicity flag per dimension required" );
+		MPI_Comm newcomm = MPI_COMM_NULL;
+		int err = MPI_Cart_create( parent.mpi_comm(),
+							  static_cast<int>(dims.size()),
+							  const_cast<int*>(&dims.front()),
+							  const_cast<int*>(&periods.front()),
+							  reorder, &newcomm );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to create cartesian communicator" );
+		}
+		return newcomm;
+	}
+
+public:
+	cartesian_comm(comm& parent, const std::vector<int>& dims,
+				   const std::vector<int>& periods, bool reorder = true) :
+		comm( create(parent, dims, periods, reorder), true ),
+		m_dims(dims),
+		m_coords(dims.size())
+	{
+		MPI_Cart_coords( mpi_comm(), rank(),
+						 static_cast<int>(m_dims.size()),
+						 &m_coords.front() );
+
+		// precompute the neighbor endpoints, one pair per dimension
+		m_neighbors.reserve( 2*m_dims.size() );
+		for(size_t dim = 0; dim < m_dims.size(); ++dim) {
+			int src, dst;
+			MPI_Cart_shift( mpi_comm(), static_cast<int>(dim), 1,
+							&src, &dst );
+			m_neighbors.push_back( endpoint(src, *this) );
+			m_neighbors.push_back( endpoint(dst, *this) );
+		}
+	}
+
+	inline size_t ndims() const { return m_dims.size(); }
+
+	inline const std::vector<int>& dims() const { return m_dims; }
+
+	// The cartesian coordinates of this rank
+	inline const std::vector<int>& coords() const { return m_coords; }
+
+	// The cached neighbor towards lower coordinates in the given dimension
+	inline endpoint& minus(size_t dim) {
+		assert( dim < m_dims.size() && "Dimension out of bounds" );
+		return m_neighbors[2*dim];
+	}
+
+	// The cached neighbor towards higher coordinates in the given dimension
+	inline endpoint& plus(size_t dim) {
+		assert( dim < m_dims.size() && "Dimension out of bounds" );
+		return m_neighbors[2*dim+1];
+	}
+
+	// Registers the per-neighbor halo block sizes (in elements), laid out
+	// like the neighbor endpoints: [2*dim] = minus, [2*dim+1] = plus. The
+	// displacements into the packed send/recv buffers are derived here and
+	// cached, so nothing is recomputed on the per-step exchange calls
+	inline cartesian_comm& set_halo(const std::vector<int>& send_counts,
+									const std::vector<int>& recv_counts)
+	{
+		assert( send_counts.size() == 2*m_dims.size() &&
+				recv_counts.size() == 2*m_dims.size() &&
+				"Two block sizes per dimension required" );
+		m_send_counts = send_counts;
+		m_recv_counts = recv_counts;
+		m_send_displs.resize( send_counts.size() );
+		m_recv_displs.resize( recv_counts.size() );
+		int snd = 0, rcv = 0;
+		for(size_t i=0; i<send_counts.size(); ++i) {
+			m_send_displs[i] = snd;		snd += send_counts[i];
+			m_recv_displs[i] = rcv;		rcv += recv_counts[i];
+		}
+		return *this;
+	}
+
+	// Total number of elements the registered pattern sends / receives,
+	// i.e. the required size of the packed buffers
+	inline int halo_send_size() const {
+		return m_send_counts.empty() ? 0 :
+			m_send_displs.back() + m_send_counts.back();
+	}
+
+	inline int halo_recv_size() const {
+		return m_recv_counts.empty() ? 0 :
+			m_recv_displs.back() + m_recv_counts.back();
+	}
+
+	// Sparse halo exchange with all the cartesian neighbors in one shot
+	// (MPI_Neighbor_alltoallv): block i of the send buffer goes to neighbor
+	// i, block i of the receive buffer is filled by neighbor i, with the
+	// counts/displacements registered via set_halo(). Only the neighbor
+	// links ever carry data, so no dense all-to-all metadata is exchanged
+	template <class SndType, class RcvType>
+	inline cartesian_comm& neighbor_exchange(msg_impl<SndType>&& snd,
+											 msg_impl<RcvType>&& rcv)
+	{
+		assert( !m_send_counts.empty() &&
+				"No halo pattern registered (see set_halo)" );
+		int err = MPI_Neighbor_alltoallv(
+					static_cast<const void*>(snd.addr()),
+					const_cast<int*>(&m_send_counts.front()),
+					const_cast<int*>(&m_send_displs.front()), snd.type(),
+					const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					const_cast<int*>(&m_recv_counts.front()),
+					const_cast<int*>(&m_recv_displs.front()), rcv.type(),
+					mpi_comm() );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to perform neighborhood exchange" );
+		}
+		return *this;
+	}
+
+	template <class SndRaw, class RcvRaw>
+	inline cartesian_comm& neighbor_exchange(const SndRaw& snd, RcvRaw& rcv) {
+		return neighbor_exchange( msg_impl<const SndRaw>(snd),
+								  msg_impl<RcvRaw>(rcv) );
+	}
+
+	// Nonblocking counterpart, returning a request to wait on; the cached
+	// pattern must stay registered until the exchange completed
+	template <class SndType, class RcvType>
+	inline request<RcvType> ineighbor_exchange(msg_impl<SndType>&& snd,
+											   msg_impl<RcvType>&& rcv)
+	{
+		assert( !m_send_counts.empty() &&
+				"No halo pattern registered (see set_halo)" );
+		MPI_Request req;
+		int err = MPI_Ineighbor_alltoallv(
+					static_cast<const void*>(snd.addr()),
+					const_cast<int*>(&m_send_counts.front()),
+					const_cast<int*>(&m_send_displs.front()), snd.type(),
+					const_cast<void*>(static_cast<const void*>(rcv.addr())),
+					const_cast<int*>(&m_recv_counts.front()),
+					const_cast<int*>(&m_recv_displs.front()), rcv.type(),
+					mpi_comm(), &req );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to post neighborhood exchange" );
+		}
+		return request<RcvType>(*this, req, std::move(rcv));
+	}
+
+	template <class SndRaw, class RcvRaw>
+	inline request<RcvRaw> ineighbor_exchange(const SndRaw& snd, RcvRaw& rcv) {
+		return ineighbor_exchange( msg_impl<const SndRaw>(snd),
+								   msg_impl<RcvRaw>(rcv) );
+	}
+
+};
+
+} // end mpi namespace
@@ -24,10 +24,18 @@
 
 #include <mpi.h>
 
+#include "detail/datatype_cache.h"
+
 #include <list>
 #include <array>
 #include <algorithm>
 #include <complex>
+#include <string>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+	#include <string_view>
+#endif
 
 namespace mpi {
 
@@ -102,6 +110,35 @@ struct mpi_type_traits<const T> {
 };
 
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//	mpi_static_size<T>: compile-time extent of a message type, for types
+//	which carry their extent in the type itself (arithmetic scalars,
+//	std::complex, std::array). For run-time sized containers `known` is
+//	false and the transfer paths query the message as usual. When the
+//	extent is known the count handed to MPI is a compile-time constant and
+//	the large-count bookkeeping folds away (see endpoint::send_impl)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class T>
+struct mpi_static_size {
+	static const bool 	known = std::is_arithmetic<T>::value;
+	static const size_t value = known ? 1 : 0;
+};
+
+template <class T>
+struct mpi_static_size<const T> : public mpi_static_size<T> { };
+
+template <class T>
+struct mpi_static_size<std::complex<T>> {
+	static const bool 	known = true;
+	static const size_t value = 1;
+};
+
+template <class T, size_t N>
+struct mpi_static_size<std::array<T,N>> {
+	static const bool 	known = std::is_arithmetic<T>::value;
+	static const size_t value = known ? N : 0;
+};
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //	std::vector<T> traits
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -123,19 +160,68 @@ struct mpi_type_traits<std::vector<T>> {
 
 };
 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//	std::string traits: characters move directly from/into the string's own
+//	storage (contiguous since C++11), no staging vector<char> copy
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <>
+struct mpi_type_traits<std::string> {
+
+	typedef char element_type;
+	typedef char* element_addr_type;
+
+	static inline size_t get_size(std::string& str) { return str.size(); }
+
+	static inline MPI_Datatype get_type(std::string&& str) {
+		return MPI_CHAR;
+	}
+
+	static inline element_addr_type get_addr(std::string& str) {
+		return &str[0];
+	}
+
+};
+
+#if __cplusplus >= 201703L
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//	std::string_view traits (C++17, send-only: a view owns no storage to
+//	receive into)
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <>
+struct mpi_type_traits<std::string_view> {
+
+	typedef const char element_type;
+	typedef const char* element_addr_type;
+
+	static inline size_t get_size(std::string_view& str) { return str.size(); }
+
+	static inline MPI_Datatype get_type(std::string_view&& str) {
+		return MPI_CHAR;
+	}
+
+	static inline element_addr_type get_addr(std::string_view& str) {
+		return str.data();
+	}
+
+};
+#endif
+
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //	std::array<T> traits
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 template <class T, size_t N>
 struct mpi_type_traits<std::array<T,N>> {
 
-	inline static size_t get_size(const std::array<T,N>& vec) { return N; }
+	typedef T element_type;
+	typedef T* element_addr_type;
 
-	inline static MPI_Datatype get_type(const std::array<T,N>& vec) {
+	inline static size_t get_size(std::array<T,N>& vec) { return N; }
+
+	inline static MPI_Datatype get_type(std::array<T,N>&& vec) {
 		return  mpi_type_traits<T>::get_type( T() );
 	}
 
-	static inline const T* get_addr(const std::array<T,N>& vec) {
+	static inline element_addr_type get_addr(std::array<T,N>& vec) {
 		return mpi_type_traits<T>::get_addr( vec.front() );
 	}
 };
@@ -149,20 +235,18 @@ struct mpi_type_traits<std::list<T>> {
 	static inline size_t get_size(const std::list<T>& vec) { return 1; }
 
 	static MPI_Datatype get_type(const std::list<T>& l) {
-		// we have to get the create an MPI_Datatype containing the offsets
+		// we have to create an MPI_Datatype containing the offsets
 		// of the current object
 
 		// we consider the offsets starting from the first element
-		std::vector<MPI_Aint> address( l.size() );
-		std::vector<int> dimension( l.size() );
-		std::vector<MPI_Datatype> types( l.size() );
+		datatype_cache::layout lo( l.size() );
 
-		std::vector<int>::iterator dim_it = dimension.begin();
-		std::vector<MPI_Aint>::iterator address_it = address.begin();
-		std::vector<MPI_Datatype>::iterator type_it = types.begin();
+		std::vector<int>::iterator dim_it = lo.dimensions.begin();
+		std::vector<MPI_Aint>::iterator address_it = lo.displacements.begin();
+		std::vector<MPI_Datatype>::iterator type_it = lo.types.begin();
 
 		MPI_Aint base_address;
-		MPI_Address(const_cast<T*>(&l.front()), &base_address);
+		MPI_Get_address(const_cast<T*>(&l.front()), &base_address);
 
 		*(type_it++) = mpi_type_traits<T>::get_type( l.front() );
 		*(dim_it++) = static_cast<int>(mpi_type_traits<T>::get_size( l.front() ));
@@ -171,11 +255,11 @@ struct mpi_type_traits<std::list<T>> {
 		typename std::list<T>::const_iterator begin = l.begin();
 		++begin;
 		std::for_each(begin, l.cend(), [&](const T& curr) {
-				assert( address_it != address.end() &&
-						  type_it != types.end() &&
-						  dim_it != dimension.end() );
+				assert( address_it != lo.displacements.end() &&
+						  type_it != lo.types.end() &&
+						  dim_it != lo.dimensions.end() );
 
-				MPI_Address(const_cast<T*>(&curr), &*address_it);
+				MPI_Get_address(const_cast<T*>(&curr), &*address_it);
 				*(address_it++) -= base_address;
 				*(type_it++) =  mpi_type_traits<T>::get_type( curr );
 				*(dim_it++) = static_cast<int>(mpi_type_traits<T>::get_size( curr ));
@@ -183,11 +267,9 @@ struct mpi_type_traits<std::list<T>> {
 			}
 		);
 
-		MPI_Datatype list_dt;
-		MPI_Type_create_struct(static_cast<int>(l.size()), &dimension.front(), &address.front(), &types.front(), &list_dt);
-		MPI_Type_commit( &list_dt );
-
-		return list_dt;
+		// the committed datatype is memoized: lists with an identical
+		// element layout reuse the same handle across sends
+		return datatype_cache::instance().lookup( std::move(lo) );
 	}
 
 	static inline const T* get_addr(const std::list<T>& list) {
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * Declarative registration of user-defined struct types: the members of a
+ * struct are described once (as a member-pointer list) and MPP derives the
+ * corresponding committed MPI datatype exactly once per type. Sending a
+ * registered struct is then as cheap as sending an array of primitives.
+ *
+ * Usage:
+ *
+ * 		struct particle { double pos[3]; double vel[3]; int id; };
+ * 		MPP_REGISTER_TYPE(particle, &particle::pos, &particle::vel,
+ * 						  &particle::id);
+ *
+ * Scalar, C array and std::array members are each described by a single
+ * member pointer.
+ */
+
+#include "detail/type_traits.h"
+#include "detail/datatype_cache.h"
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// type_builder: accumulates the layout of a struct (member displacements
+// relative to the struct base and member datatypes) and builds from it the
+// committed MPI datatype, resized to sizeof(T) so that arrays of T can be
+// sent with a plain count
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class T>
+class type_builder {
+
+	T 							m_probe;
+	MPI_Aint					m_base;
+	std::vector<int> 			m_dims;
+	std::vector<MPI_Aint> 		m_displ;
+	std::vector<MPI_Datatype> 	m_types;
+
+public:
+	type_builder() : m_probe() {
+		MPI_Get_address( &m_probe, &m_base );
+	}
+
+	template <class M>
+	inline type_builder<T>& add(M T::*member) {
+		MPI_Aint addr;
+		MPI_Get_address( &(m_probe.*member), &addr );
+		m_displ.push_back( addr - m_base );
+		m_dims.push_back(
+			static_cast<int>(mpi_type_traits<M>::get_size( m_probe.*member )) );
+		m_types.push_back( mpi_type_traits<M>::get_type( M() ) );
+		return *this;
+	}
+
+	// C array members are flattened to (count x element type)
+	template <class M, size_t N>
+	inline type_builder<T>& add(M (T::*member)[N]) {
+		MPI_Aint addr;
+		MPI_Get_address( &(m_probe.*member), &addr );
+		m_displ.push_back( addr - m_base );
+		m_dims.push_back( static_cast<int>(N) );
+		m_types.push_back( mpi_type_traits<M>::get_type( M() ) );
+		return *this;
+	}
+
+	inline MPI_Datatype build() {
+		MPI_Datatype dt, resized;
+		MPI_Type_create_struct( static_cast<int>(m_dims.size()),
+								&m_dims.front(),
+								&m_displ.front(),
+								&m_types.front(),
+								&dt );
+		// extend the type to cover padding, so that contiguous arrays of T
+		// can be transferred with a plain element count
+		MPI_Type_create_resized( dt, 0, sizeof(T), &resized );
+		MPI_Type_free( &dt );
+		MPI_Type_commit( &resized );
+		// freed by mpi::finalize() together with the cached layouts
+		datatype_cache::instance().adopt( resized );
+		return resized;
+	}
+};
+
+template <class T, class... Members>
+inline MPI_Datatype make_user_type(Members T::*... members) {
+	type_builder<T> builder;
+	// poor man's fold: expand the member-pointer pack in order
+	int expand[] = { 0, (builder.add(members), 0)... };
+	(void) expand;
+	return builder.build();
+}
+
+} // end mpi namespace
+
+/**
+ * Specializes mpi_type_traits for the given struct: the committed datatype
+ * is built on first use and memoized for the program lifetime. Must be
+ * invoked at global scope
+ */
+#define MPP_REGISTER_TYPE(Type, ...) \
+	namespace mpi { \
+	template <> \
+	inline MPI_Datatype mpi_type_traits<Type>::get_type(Type&&) { \
+		static MPI_Datatype dt = make_user_type<Type>(__VA_ARGS__); \
+		return dt; \
+	} \
+	} // end mpi namespace
@@ -0,0 +1,224 @@
+/******************************************************************************
+ *
+ *                          MPP: An MPI CPP Interface
+ *
+ *                  Copyright (C) 2011-2012  Simone Pellegrini
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation; either version 2.1 of the License, or (at your
+ * option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "detail/decls.h"
+
+#include "detail/error.h"
+#include "detail/comm.h"
+#include "detail/message.h"
+#include "detail/type_traits.h"
+#include "detail/request.h"
+
+#include <type_traits>
+
+namespace mpi {
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// window<T>: wrapper for MPI one-sided communication. Exposes a local
+// buffer (described by mpi_type_traits, e.g. a std::vector) to the ranks
+// of a communicator; remote memory is then addressed through the same
+// operator() idiom used for two-sided endpoints, with no matching receive
+// on the target side:
+//
+// 		window<std::vector<double>> win(comm::world, buf);
+// 		win.lock_all();						// passive-target epoch
+// 		auto r = win(1).put( msg(v), off );	// elements [off, off+v.size())
+// 		r.get();							// local completion
+// 		win.flush(1);						// remote completion
+// 		...
+// 		win.unlock_all();
+//
+// put/get/accumulate use the request-based RMA calls and hand back the
+// usual request<T>, so completion composes with request_set and the
+// progress engine. Displacements are expressed in elements of the exposed
+// buffer
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <class WinType>
+class window {
+
+	typedef typename std::remove_const<
+		typename mpi_type_traits<WinType>::element_type>::type element_type;
+
+	const comm& 	m_comm;
+	MPI_Win 		m_win;
+	bool 			m_locked;
+
+	// Make this class non-copyable
+	window(const window<WinType>& other) = delete;
+	window<WinType>& operator=(const window<WinType>& other) = delete;
+
+public:
+
+	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	// target: the window region exposed by one particular rank, obtained
+	// via window::operator()
+	//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+	class target {
+
+		window<WinType>& 	m_win;
+		const int 			m_rank;
+
+		target(window<WinType>& win, int rank) :
+			m_win(win), m_rank(rank) { }
+
+		friend class window<WinType>;
+
+	public:
+		// Writes the message payload into the target region starting at
+		// the given element displacement
+		template <class MsgType>
+		inline request<MsgType> put(msg_impl<MsgType>&& m, MPI_Aint disp = 0) {
+			MPI_Request req = MPI_REQUEST_NULL;
+			int err = MPI_Rput(
+					const_cast<void*>(static_cast<const void*>(m.addr())),
+					static_cast<int>(m.size()), m.type(),
+					m_rank, disp,
+					static_cast<int>(m.size()), m.type(),
+					m_win.m_win, &req );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to put into window of rank '" << m_rank << "'" );
+			}
+			return request<MsgType>(m_win.m_comm, req, std::move(m));
+		}
+
+		template <class RawType>
+		inline request<const RawType> put(const RawType& m, MPI_Aint disp = 0) {
+			return put( std::move( msg_impl<const RawType>(m) ), disp );
+		}
+
+		// Reads from the target region (starting at the given element
+		// displacement) into the message payload
+		template <class MsgType>
+		inline request<MsgType> get(msg_impl<MsgType>&& m, MPI_Aint disp = 0) {
+			MPI_Request req = MPI_REQUEST_NULL;
+			int err = MPI_Rget(
+					static_cast<void*>(m.addr()),
+					static_cast<int>(m.size()), m.type(),
+					m_rank, disp,
+					static_cast<int>(m.size()), m.type(),
+					m_win.m_win, &req );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to get from window of rank '" << m_rank << "'" );
+			}
+			return request<MsgType>(m_win.m_comm, req, std::move(m));
+		}
+
+		template <class RawType>
+		inline request<RawType> get(RawType& m, MPI_Aint disp = 0) {
+			return get( std::move( msg_impl<RawType>(m) ), disp );
+		}
+
+		// Combines the message payload into the target region with the
+		// given reduction operation (element-wise, atomic per element)
+		template <class MsgType>
+		inline request<MsgType> accumulate(msg_impl<MsgType>&& m,
+										   MPI_Op op = MPI_SUM,
+										   MPI_Aint disp = 0) {
+			MPI_Request req = MPI_REQUEST_NULL;
+			int err = MPI_Raccumulate(
+					const_cast<void*>(static_cast<const void*>(m.addr())),
+					static_cast<int>(m.size()), m.type(),
+					m_rank, disp,
+					static_cast<int>(m.size()), m.type(),
+					op, m_win.m_win, &req );
+			if ( err != MPI_SUCCESS ) {
+				MPP_REPORT_ERROR( err,
+					"Failed to accumulate into window of rank '"
+						<< m_rank << "'" );
+			}
+			return request<MsgType>(m_win.m_comm, req, std::move(m));
+		}
+
+		template <class RawType>
+		inline request<const RawType> accumulate(const RawType& m,
+												 MPI_Op op = MPI_SUM,
+												 MPI_Aint disp = 0) {
+			return accumulate( std::move( msg_impl<const RawType>(m) ),
+							   op, disp );
+		}
+	};
+
+	// Exposes the given buffer to the ranks of the communicator
+	// (collective over the communicator)
+	window(const comm& com, WinType& buf) :
+		m_comm(com), m_win(MPI_WIN_NULL), m_locked(false)
+	{
+		int err = MPI_Win_create(
+				mpi_type_traits<WinType>::get_addr(buf),
+				static_cast<MPI_Aint>( mpi_type_traits<WinType>::get_size(buf)
+									   * sizeof(element_type) ),
+				static_cast<int>( sizeof(element_type) ),
+				MPI_INFO_NULL, com.mpi_comm(), &m_win );
+		if ( err != MPI_SUCCESS ) {
+			MPP_REPORT_ERROR( err, "Failed to create RMA window" );
+		}
+	}
+
+	window(window<WinType>&& other) :
+		m_comm( other.m_comm ),
+		m_win( other.m_win ),
+		m_locked( other.m_locked )
+	{
+		other.m_win = MPI_WIN_NULL;
+		other.m_locked = false;
+	}
+
+	// Frees the window (collective, like its creation)
+	~window() {
+		if ( m_win == MPI_WIN_NULL ) { return; }
+		if ( m_locked ) { MPI_Win_unlock_all(m_win); }
+		MPI_Win_free(&m_win);
+	}
+
+	// Opens a passive-target access epoch towards every rank
+	inline void lock_all() {
+		MPI_Win_lock_all(0, m_win);
+		m_locked = true;
+	}
+
+	inline void unlock_all() {
+		MPI_Win_unlock_all(m_win);
+		m_locked = false;
+	}
+
+	// Completes all outstanding operations towards the given rank, at both
+	// the origin and the target
+	inline void flush(int rank) { MPI_Win_flush(rank, m_win); }
+
+	inline void flush_all() { MPI_Win_flush_all(m_win); }
+
+	// Synchronizes the private and public copy of the exposed buffer;
+	// needed before reading locally what a remote rank put here (paired
+	// with some process synchronization, e.g. a barrier)
+	inline void sync() { MPI_Win_sync(m_win); }
+
+	inline target operator()(int rank) { return target(*this, rank); }
+
+	inline const MPI_Win& mpi_win() const { return m_win; }
+
+};
+
+} // end mpi namespace
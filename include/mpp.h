@@ -23,10 +23,27 @@
 #pragma once
 
 #include "detail/comm.h"
+#include "detail/collectives.h"
+#include "detail/op.h"
 #include "detail/endpoint.h"
+#include "detail/topology.h"
 #include "detail/message.h"
 #include "detail/status.h"
 #include "detail/request.h"
+#include "detail/request_set.h"
+#include "detail/post.h"
+#include "detail/task.h"
+#include "detail/user_type.h"
+#include "detail/device.h"
+#include "detail/channel.h"
+#include "detail/ready.h"
+#include "detail/packed.h"
+#include "detail/aggregate.h"
+#include "detail/window.h"
+#include "detail/shared_window.h"
+#include "detail/file.h"
+#include "detail/dispatcher.h"
+#include "detail/progress.h"
 
 #include <exception>
 
@@ -57,20 +74,49 @@ enum thread_level { NO_THREAD,
 				  };
 
 inline void init(int argc = 0, char* argv[] = NULL, const thread_level required = NO_THREAD) {
-	if(required == NO_THREAD) { 
+	if(required == NO_THREAD) {
 		MPI_Init(&argc, &argv);
-		return;
+	} else {
+		// map the requested level on the corresponding MPI constant
+		int level = MPI_THREAD_SINGLE;
+		switch(required) {
+		case THREAD_SINGLE: 	level = MPI_THREAD_SINGLE; 		break;
+		case THREAD_FUNNELED: 	level = MPI_THREAD_FUNNELED; 	break;
+		case THREAD_SERIALIZED: level = MPI_THREAD_SERIALIZED; 	break;
+		case THREAD_MULTIPLE: 	level = MPI_THREAD_MULTIPLE; 	break;
+		default: break;
+		}
+
+		int provided;
+		// try initialize with the provided thread level
+		MPI_Init_thread(&argc, &argv, level, &provided);
+
+		if (provided < level)
+			throw ThreadLevelException(level, provided);
 	}
-	
-	int provided;
-	// try initialize with the provided thread level
-	MPI_Init_thread(&argc, &argv, required, &provided);
 
-	if (provided < required) 
-		throw ThreadLevelException(required, provided);
+	// snapshot world's rank/size right away, so rank() never has to take
+	// the lazy attach path (and is safe from any thread, see comm.h)
+	comm::world.attach();
+
+#if defined(MPP_ERROR_CODES)
+	// error-code policy: failed MPI calls must report back to the caller
+	// instead of aborting the job (see error.h)
+	MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN);
+#endif
 }
 
-inline void finalize(){ MPI_Finalize(); }
+inline void finalize(){
+	// shut down the background progress thread (no-op when never started)
+	progress_engine::instance().stop();
+	// release the registered reduction operations and the committed
+	// datatypes memoized during the program execution
+	op_cache::instance().clear();
+	datatype_cache::instance().clear();
+	// release the node-local communicator (if ever created)
+	comm::free_node();
+	MPI_Finalize();
+}
 
 } // end mpi namespace
 
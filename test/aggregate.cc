@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Aggregate, Coalesce) {
+	if ( comm::world.rank() == 0 ) {
+		aggregator agg( comm::world(1) );
+		for(int i=0; i<100; ++i) {
+			agg.send( i );
+		}
+		// everything fits in the staging buffer: nothing left the node yet
+		EXPECT_EQ( 100u * (sizeof(unsigned int)+sizeof(int)), agg.pending() );
+		agg.flush();
+		EXPECT_EQ( 0u, agg.pending() );
+		return;
+	}
+
+	disaggregator frames( comm::world(0) );
+	int count = 0;
+	while( !frames.empty() ) {
+		EXPECT_EQ( sizeof(int), frames.next_size() );
+		EXPECT_EQ( count, frames.next<int>() );
+		++count;
+	}
+	EXPECT_EQ( 100, count );
+}
+
+TEST(Aggregate, MixedPayloads) {
+	if ( comm::world.rank() == 0 ) {
+		std::vector<double> v{ 1.5, 2.5, 3.5 };
+
+		aggregator agg( comm::world(1) );
+		agg.send( 42 ).send( v ).send( 3.25 );
+		// the destructor flushes the remaining frames
+		return;
+	}
+
+	disaggregator frames( comm::world(0) );
+	EXPECT_EQ( 42, frames.next<int>() );
+
+	std::vector<double> v;
+	frames.next( v );
+	ASSERT_EQ( 3u, v.size() );
+	EXPECT_EQ( 2.5, v[1] );
+
+	EXPECT_EQ( 3.25, frames.next<double>() );
+	EXPECT_TRUE( frames.empty() );
+}
+
+TEST(Aggregate, ThresholdBypass) {
+	if ( comm::world.rank() == 0 ) {
+		std::vector<int> big(1024);
+		for(size_t i=0; i<big.size(); ++i) { big[i] = static_cast<int>(i); }
+
+		aggregator agg( comm::world(1) );
+		agg.send( big );
+		// too large to coalesce: sent directly, nothing was staged
+		EXPECT_EQ( 0u, agg.pending() );
+		return;
+	}
+
+	std::vector<int> big(1024, -1);
+	auto s = comm::world(0) >> big;
+	EXPECT_EQ( 1024, s.count() );
+	EXPECT_EQ( 100, big[100] );
+}
+
+TEST(Aggregate, TagChangeFlush) {
+	if ( comm::world.rank() == 0 ) {
+		aggregator agg( comm::world(1) );
+		agg.send( 1, 7 );
+		agg.send( 2, 7 );
+		// switching tag ships the tag-7 frames as their own wire message
+		agg.send( 3, 9 );
+		return;
+	}
+
+	disaggregator first( comm::world(0), 7 );
+	EXPECT_EQ( 1, first.next<int>() );
+	EXPECT_EQ( 2, first.next<int>() );
+	EXPECT_TRUE( first.empty() );
+
+	disaggregator second( comm::world(0), 9 );
+	EXPECT_EQ( 3, second.next<int>() );
+	EXPECT_TRUE( second.empty() );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
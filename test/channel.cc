@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Channel, SendRecv) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> out(4);
+	std::vector<int> in(4, -1);
+
+	auto send = comm::world(other).send_init( msg(out) );
+	auto recv = comm::world(other).recv_init( msg(in) );
+
+	// re-use the same channels across iterations
+	for(int iter=0; iter<10; ++iter) {
+		for(size_t i=0; i<out.size(); ++i) {
+			out[i] = iter*10 + static_cast<int>(i);
+		}
+
+		recv.start();
+		send.start();
+		auto s = recv.wait();
+		send.wait();
+
+		EXPECT_EQ( 4, s.count() );
+		EXPECT_EQ( other, s.source().rank() );
+		for(size_t i=0; i<in.size(); ++i) {
+			EXPECT_EQ( iter*10 + static_cast<int>(i), in[i] );
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Collectives, Bcast) {
+	int val = comm::world.rank() == 0 ? 42 : -1;
+	comm::world.bcast(val, 0);
+	EXPECT_EQ(42, val);
+}
+
+TEST(Collectives, BcastVector) {
+	std::vector<int> vec(4, -1);
+	if (comm::world.rank() == 0) {
+		for(size_t i=0; i<vec.size(); ++i) { vec[i] = static_cast<int>(i); }
+	}
+	comm::world.bcast(vec, 0);
+	for(size_t i=0; i<vec.size(); ++i) {
+		EXPECT_EQ( static_cast<int>(i), vec[i] );
+	}
+}
+
+TEST(Collectives, Reduce) {
+	int val = comm::world.rank() + 1;
+	int sum = 0;
+	comm::world.reduce(val, sum, MPI_SUM, 0);
+	if (comm::world.rank() == 0) {
+		int n = comm::world.size();
+		EXPECT_EQ( n*(n+1)/2, sum );
+	}
+}
+
+TEST(Collectives, Allreduce) {
+	int val = comm::world.rank() + 1;
+	int max = 0;
+	comm::world.allreduce(val, max, MPI_MAX);
+	EXPECT_EQ( comm::world.size(), max );
+}
+
+TEST(Collectives, FunctorAllreduce) {
+	int val = comm::world.rank() + 1;
+	int sum = 0;
+	// std::plus maps onto MPI_SUM at compile time
+	comm::world.allreduce(val, sum, std::plus<int>());
+	int n = comm::world.size();
+	EXPECT_EQ( n*(n+1)/2, sum );
+}
+
+TEST(Collectives, FunctorReduceMax) {
+	int val = comm::world.rank() + 1;
+	int max = 0;
+	comm::world.reduce(val, max, mpi::maximum<int>(), 0);
+	if (comm::world.rank() == 0) {
+		EXPECT_EQ( comm::world.size(), max );
+	}
+}
+
+TEST(Collectives, CustomOp) {
+	std::vector<int> val{ comm::world.rank() + 1, comm::world.rank() * 4 };
+	std::vector<int> out(2, 0);
+
+	// not a recognized functor: registered once through MPI_Op_create
+	auto xr = [](int a, int b) { return a ^ b; };
+	comm::world.allreduce(val, out, xr);
+
+	int expected0 = 0, expected1 = 0;
+	for(int r=0; r<comm::world.size(); ++r) {
+		expected0 ^= r + 1;
+		expected1 ^= r * 4;
+	}
+	EXPECT_EQ( expected0, out[0] );
+	EXPECT_EQ( expected1, out[1] );
+
+	// a second reduction reuses the cached handle
+	comm::world.allreduce(val, out, xr);
+	EXPECT_EQ( expected0, out[0] );
+}
+
+TEST(Collectives, ScatterGather) {
+	int n = comm::world.size();
+
+	std::vector<int> snd;
+	if (comm::world.rank() == 0) {
+		snd.resize(2*n);
+		for(size_t i=0; i<snd.size(); ++i) { snd[i] = static_cast<int>(i); }
+	} else {
+		snd.resize(2*n, -1);
+	}
+
+	std::vector<int> part(2, -1);
+	comm::world.scatter(snd, part, 0);
+	EXPECT_EQ( 2*comm::world.rank(), part[0] );
+	EXPECT_EQ( 2*comm::world.rank()+1, part[1] );
+
+	// double each element and gather the result back on rank 0
+	for(int& cur : part) { cur *= 2; }
+
+	std::vector<int> rcv(2*n, -1);
+	comm::world.gather(part, rcv, 0);
+	if (comm::world.rank() == 0) {
+		for(size_t i=0; i<rcv.size(); ++i) {
+			EXPECT_EQ( 2*static_cast<int>(i), rcv[i] );
+		}
+	}
+}
+
+TEST(Collectives, IAllreduce) {
+	int val = comm::world.rank();
+	int sum = -1;
+	auto req = comm::world.iallreduce(val, sum, MPI_SUM);
+
+	request_set set;
+	set.add( std::move(req) );
+	set.wait_all();
+
+	int n = comm::world.size();
+	EXPECT_EQ( n*(n-1)/2, sum );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
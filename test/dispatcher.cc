@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Dispatcher, TwoTags) {
+	if ( comm::world.rank() == 0 ) {
+		// burst of work messages plus a couple of control ones
+		for(int i=0; i<10; ++i) {
+			std::vector<int> w{ i, i*2 };
+			comm::world(1).send( msg(w, 1) );
+		}
+		double a = 3.5, b = 7.25;
+		comm::world(1).send( msg(a, 2) );
+		comm::world(1).send( msg(b, 2) );
+
+		// wait for the acknowledgment
+		int ack = -1;
+		comm::world(1) >> ack;
+		EXPECT_EQ( 12, ack );
+		return;
+	}
+
+	int work_sum = 0, work_msgs = 0;
+	double ctrl_sum = 0.0;
+	size_t received = 0;
+
+	dispatcher disp;
+	disp.on<int>( 1, [&](std::vector<int>& w, status& s) {
+		EXPECT_EQ( 0, s.source().rank() );
+		EXPECT_EQ( 2u, w.size() );
+		work_sum += w[0] + w[1];
+		++work_msgs;
+		++received;
+	});
+	disp.on<double>( 2, [&](std::vector<double>& c, status& s) {
+		ASSERT_EQ( 1u, c.size() );
+		ctrl_sum += c[0];
+		++received;
+	});
+
+	while( received < 12 ) { disp.poll(); }
+
+	EXPECT_EQ( 10, work_msgs );
+	EXPECT_EQ( 135, work_sum );		// sum of i + 2i for i in [0,10)
+	EXPECT_EQ( 10.75, ctrl_sum );
+
+	comm::world(0).send( static_cast<int>(received) );
+}
+
+TEST(Dispatcher, RunStop) {
+	if ( comm::world.rank() == 0 ) {
+		for(int i=0; i<5; ++i) {
+			comm::world(1).send( msg(i, 3) );
+		}
+		return;
+	}
+
+	int count = 0;
+	dispatcher disp;
+	disp.on<int>( 3, [&](std::vector<int>&, status&) {
+		if ( ++count == 5 ) { disp.stop(); }
+	});
+
+	size_t total = disp.run();
+	EXPECT_EQ( 5u, total );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Exchange, Fused) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> out(4, comm::world.rank());
+	std::vector<int> in(4, -1);
+
+	// both ranks issue the same call: no ordering to hand-manage
+	auto s = comm::world(other).exchange( msg(out), msg(in) );
+
+	EXPECT_EQ( 4, s.count() );
+	EXPECT_EQ( other, s.source().rank() );
+	for(size_t i=0; i<in.size(); ++i) {
+		EXPECT_EQ( other, in[i] );
+	}
+}
+
+TEST(Exchange, Async) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<double> out(8);
+	std::vector<double> in(8, -1.0);
+	for(size_t i=0; i<out.size(); ++i) {
+		out[i] = comm::world.rank()*10.0 + i;
+	}
+
+	auto reqs = comm::world(other).iexchange( msg(out), msg(in) );
+	EXPECT_EQ( 2u, reqs.size() );
+	reqs.wait_all();
+
+	// index 0 is the receive leg
+	EXPECT_EQ( other, reqs.status_of(0).source().rank() );
+	for(size_t i=0; i<in.size(); ++i) {
+		EXPECT_EQ( other*10.0 + i, in[i] );
+	}
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+namespace {
+	const char* path = "./ut_file.tmp";
+	const int block = 64;
+}
+
+TEST(File, CollectiveWriteRead) {
+	int rank = comm::world.rank();
+
+	std::vector<int> out(block);
+	for(int i=0; i<block; ++i) { out[i] = rank*1000 + i; }
+
+	{
+		file f(path);
+		// each rank writes its own contiguous block
+		f.at( rank * block * sizeof(int) ) << msg(out);
+		f.sync();
+
+		EXPECT_EQ( static_cast<MPI_Offset>(2 * block * sizeof(int)),
+				   f.size() );
+	}
+
+	// read back the block written by the other rank
+	int other = rank == 0 ? 1 : 0;
+	std::vector<int> in(block, -1);
+	{
+		file f(path);
+		f.at( other * block * sizeof(int) ) >> msg(in);
+	}
+
+	for(int i=0; i<block; ++i) {
+		EXPECT_EQ( other*1000 + i, in[i] );
+	}
+}
+
+TEST(File, CursorAdvances) {
+	int rank = comm::world.rank();
+
+	double a = rank + 0.25, b = rank + 0.5;
+	file f(path);
+
+	auto c = f.at( (2*block*sizeof(int)) + rank * 2 * sizeof(double) );
+	c << msg(a) << msg(b);
+	EXPECT_EQ( static_cast<MPI_Offset>(
+				(2*block*sizeof(int)) + (rank*2 + 2) * sizeof(double) ),
+			   c.offset() );
+
+	double ra = -1.0, rb = -1.0;
+	f.at( (2*block*sizeof(int)) + rank * 2 * sizeof(double) )
+		>> msg(ra) >> msg(rb);
+
+	EXPECT_EQ( a, ra );
+	EXPECT_EQ( b, rb );
+}
+
+TEST(File, Nonblocking) {
+	int rank = comm::world.rank();
+
+	std::vector<float> out(block, rank + 1.5f);
+
+	{
+		file f(path);
+		auto req = f.at( rank * block * sizeof(float) ).iwrite( msg(out) );
+		req.get();
+		f.sync();
+	}
+
+	int other = rank == 0 ? 1 : 0;
+	std::vector<float> in(block, -1.0f);
+	{
+		file f(path);
+		auto req = f.at( other * block * sizeof(float) ).iread( msg(in) );
+		req.get();
+	}
+
+	for(int i=0; i<block; ++i) {
+		EXPECT_EQ( other + 1.5f, in[i] );
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	if ( rank == 0 ) { file::remove(path); }
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
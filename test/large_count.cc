@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+// The real trigger (more than 2^31-1 elements) needs >8GB buffers, so the
+// chunked layout is exercised here with an artificially small chunk width
+
+TEST(LargeCount, ChunkedLayout) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	// 1000 = 62 full chunks of 16 plus a remainder of 8
+	std::vector<int> buf(1000);
+
+	if ( comm::world.rank() == 0 ) {
+		for(size_t i=0; i<buf.size(); ++i) { buf[i] = static_cast<int>(i); }
+
+		large_count_type big( buf.size(), MPI_INT, 16 );
+		MPI_Send( &buf.front(), 1, big.type(), other, 0, MPI_COMM_WORLD );
+		return;
+	}
+
+	large_count_type big( buf.size(), MPI_INT, 16 );
+	MPI_Status stat;
+	MPI_Recv( &buf.front(), 1, big.type(), other, 0, MPI_COMM_WORLD, &stat );
+
+	for(size_t i=0; i<buf.size(); ++i) {
+		EXPECT_EQ( static_cast<int>(i), buf[i] );
+	}
+}
+
+TEST(LargeCount, ExactChunks) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	// no remainder: the vector type alone describes the payload
+	std::vector<double> buf(64);
+
+	if ( comm::world.rank() == 0 ) {
+		for(size_t i=0; i<buf.size(); ++i) { buf[i] = i * 0.5; }
+
+		large_count_type big( buf.size(), MPI_DOUBLE, 16 );
+		MPI_Send( &buf.front(), 1, big.type(), other, 0, MPI_COMM_WORLD );
+		return;
+	}
+
+	// the receiver may as well use the plain count
+	MPI_Status stat;
+	MPI_Recv( &buf.front(), 64, MPI_DOUBLE, other, 0, MPI_COMM_WORLD, &stat );
+
+	EXPECT_EQ( 31.5, buf[63] );
+}
+
+TEST(LargeCount, Needed) {
+	EXPECT_FALSE( large_count_type::needed( 0 ) );
+	EXPECT_FALSE( large_count_type::needed( 2147483647u ) );
+	EXPECT_TRUE( large_count_type::needed( 2147483648u ) );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
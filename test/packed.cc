@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <list>
+#include <set>
+#include <map>
+
+using namespace mpi;
+
+TEST(Packed, List) {
+	if ( comm::world.rank() == 0 ) {
+		std::list<double> out{ 1.5, 2.5, 3.5, 4.5 };
+		comm::world(1).send_packed( out );
+		return;
+	}
+
+	std::list<double> in;
+	auto s = comm::world(0).recv_packed( in );
+	EXPECT_EQ( 0, s.source().rank() );
+	ASSERT_EQ( 4u, in.size() );
+	EXPECT_EQ( 1.5, in.front() );
+	EXPECT_EQ( 4.5, in.back() );
+}
+
+TEST(Packed, Set) {
+	if ( comm::world.rank() == 0 ) {
+		std::set<int> out{ 7, 3, 11 };
+		comm::world(1).send_packed( out );
+		return;
+	}
+
+	std::set<int> in;
+	comm::world(0).recv_packed( in );
+	ASSERT_EQ( 3u, in.size() );
+	EXPECT_EQ( 1u, in.count(3) );
+	EXPECT_EQ( 1u, in.count(7) );
+	EXPECT_EQ( 1u, in.count(11) );
+}
+
+TEST(Packed, Map) {
+	if ( comm::world.rank() == 0 ) {
+		std::map<int, double> out;
+		out[1] = 0.5;
+		out[4] = 2.0;
+		out[9] = 4.5;
+		comm::world(1).send_packed( out );
+		return;
+	}
+
+	std::map<int, double> in;
+	comm::world(0).recv_packed( in );
+	ASSERT_EQ( 3u, in.size() );
+	EXPECT_EQ( 0.5, in[1] );
+	EXPECT_EQ( 2.0, in[4] );
+	EXPECT_EQ( 4.5, in[9] );
+}
+
+TEST(Packed, ArenaRecycled) {
+	if ( comm::world.rank() == 0 ) {
+		std::list<int> out;
+		for(int i=0; i<256; ++i) { out.push_back(i); }
+
+		comm::world(1).send_packed( out );
+		const char* grown = &pack_arena::buffer().front();
+
+		// subsequent, equally sized sends reuse the grown buffer
+		comm::world(1).send_packed( out );
+		EXPECT_EQ( grown, &pack_arena::buffer().front() );
+		return;
+	}
+
+	std::list<int> in;
+	comm::world(0).recv_packed( in );
+	comm::world(0).recv_packed( in );
+	EXPECT_EQ( 256u, in.size() );
+	EXPECT_EQ( 255, in.back() );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+using namespace mpi;
+
+TEST(Progress, RankFromAnyThread) {
+	// mpi::init attached comm::world: rank()/size() read immutable state
+	// and are safe to call concurrently from worker threads
+	int r = comm::world.rank();
+	int s = comm::world.size();
+
+	std::atomic<int> mismatches(0);
+	std::vector<std::thread> threads;
+	for(int i=0; i<4; ++i) {
+		threads.emplace_back( [&]() {
+			for(int k=0; k<1000; ++k) {
+				if ( comm::world.rank() != r || comm::world.size() != s ) {
+					++mismatches;
+				}
+			}
+		} );
+	}
+	for(size_t i=0; i<threads.size(); ++i) { threads[i].join(); }
+
+	EXPECT_EQ( 0, mismatches.load() );
+}
+
+TEST(Progress, BackgroundCompletion) {
+	progress_engine& engine = progress_engine::instance();
+	engine.start();
+
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	// large enough to take the rendezvous path
+	std::vector<double> out(1 << 20, comm::world.rank() + 0.5);
+	std::vector<double> in(1 << 20, -1.0);
+
+	auto t_recv = engine.submit( comm::world(other) > msg(in) );
+	auto t_send = engine.submit( comm::world(other).isend( msg(out) ) );
+
+	// "compute" while the engine progresses the transfer
+	std::this_thread::sleep_for( std::chrono::milliseconds(50) );
+
+	auto s = engine.wait(t_recv);
+	engine.wait(t_send);
+
+	EXPECT_EQ( other, s.source().rank() );
+	for(size_t i=0; i<in.size(); i += (1 << 16)) {
+		EXPECT_EQ( other + 0.5, in[i] );
+	}
+}
+
+TEST(Progress, Poll) {
+	progress_engine& engine = progress_engine::instance();
+	engine.start();
+
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	// drain completions left over by previous tests
+	engine.poll( [](progress_engine::ticket) { } );
+
+	int out = comm::world.rank(), in = -1;
+	auto t_recv = engine.submit( comm::world(other) > in );
+	auto t_send = engine.submit( comm::world(other).isend(out) );
+
+	size_t completed = 0;
+	while( completed < 2 ) {
+		engine.poll( [&](progress_engine::ticket t) {
+			EXPECT_TRUE( t == t_recv || t == t_send );
+			engine.release(t);
+			++completed;
+		} );
+	}
+
+	EXPECT_EQ( other, in );
+}
+
+TEST(Progress, Then) {
+	progress_engine& engine = progress_engine::instance();
+	engine.start();
+
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> out(4, comm::world.rank());
+	std::vector<int> in(4, -1);
+
+	std::atomic<bool> fired(false);
+	std::atomic<int> count(-1), tag(-1);
+
+	// attach a continuation to a pending receive: it runs on the progress
+	// thread with the completion status
+	auto req = comm::world(other) > msg(in, 7);
+	req.then( [&](const status& s) {
+		count.store( s.count() );
+		tag.store( s.tag() );
+		fired.store(true);
+	} );
+
+	comm::world(other).send( msg(out, 7) );
+	while( !fired.load() ) { std::this_thread::yield(); }
+
+	EXPECT_EQ( 4, count.load() );
+	EXPECT_EQ( 7, tag.load() );
+	for(size_t i=0; i<in.size(); ++i) { EXPECT_EQ( other, in[i] ); }
+
+	// detached continuations hand their slot back to the engine once
+	// fired: repeating the pattern does not grow the arena
+	size_t high_water = engine.arena_size();
+	for(int round=0; round<10; ++round) {
+		std::atomic<bool> done(false);
+		auto r = comm::world(other) > msg(in);
+		r.then( [&](const status&) { done.store(true); } );
+		comm::world(other).send( msg(out) );
+		while( !done.load() ) { std::this_thread::yield(); }
+	}
+	EXPECT_EQ( high_water, engine.arena_size() );
+}
+
+TEST(Progress, SlotRecycling) {
+	progress_engine& engine = progress_engine::instance();
+	engine.start();
+
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	const int batch = 8;
+	std::vector<int> out(batch), in(batch, -1);
+
+	// waiting hands each slot back to the pool, so repeated rounds reuse
+	// the same arena instead of growing it
+	size_t high_water = 0;
+	for(int round=0; round<20; ++round) {
+		std::vector<progress_engine::ticket> ts;
+		for(int i=0; i<batch; ++i) {
+			out[i] = round*batch + i;
+			ts.push_back( engine.submit( comm::world(other) > msg(in[i]) ) );
+			ts.push_back( engine.submit( comm::world(other).isend( msg(out[i]) ) ) );
+		}
+		for(size_t i=0; i<ts.size(); ++i) { engine.wait(ts[i]); }
+
+		if (round == 0) { high_water = engine.arena_size(); }
+	}
+
+	EXPECT_EQ( high_water, engine.arena_size() );
+	for(int i=0; i<batch; ++i) {
+		EXPECT_EQ( 19*batch + i, in[i] );
+	}
+}
+
+int main(int argc, char** argv) {
+	mpi::init(argc, argv, mpi::THREAD_MULTIPLE);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	mpi::finalize();
+	return static_cast<int>(errcode);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Ready, SendRecv) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> out(4);
+	std::vector<int> in(4, -1);
+
+	auto tx = comm::world(other).rsend_init( msg(out) );
+	auto rx = comm::world(other).rrecv_init( msg(in) );
+
+	// same pairing reused across iterations, both directions per round
+	for(int iter=0; iter<10; ++iter) {
+		for(size_t i=0; i<out.size(); ++i) {
+			out[i] = iter*10 + static_cast<int>(i);
+		}
+
+		rx.arm();
+		tx.send();
+		auto s = rx.wait();
+
+		EXPECT_EQ( 4, s.count() );
+		EXPECT_EQ( other, s.source().rank() );
+		for(size_t i=0; i<in.size(); ++i) {
+			EXPECT_EQ( iter*10 + static_cast<int>(i), in[i] );
+		}
+	}
+}
+
+TEST(Ready, OneWay) {
+	if ( comm::world.rank() == 0 ) {
+		double v = 2.75;
+		auto tx = comm::world(1).rsend_init( msg(v) );
+		tx.send();
+		return;
+	}
+
+	double v = 0.0;
+	auto rx = comm::world(0).rrecv_init( msg(v) );
+	rx.arm();
+	rx.wait();
+	EXPECT_EQ( 2.75, v );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(RequestSet, WaitAll) {
+	std::vector<int> out(4, comm::world.rank());
+	std::vector<int> in(4, -1);
+
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	request_set set;
+	set.add( comm::world(other) > in );
+	set.add( comm::world(other).isend(out) );
+	set.wait_all();
+
+	EXPECT_EQ( static_cast<size_t>(2), set.size() );
+	for(int cur : in) { EXPECT_EQ(other, cur); }
+}
+
+TEST(RequestSet, Post) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<double> a(8, comm::world.rank() + 0.5);
+	int b = comm::world.rank() * 10;
+
+	std::vector<double> in_a(8, -1.0);
+	int in_b = -1;
+
+	// the whole batch is posted in one shot; the handles land in a
+	// contiguous set ready for wait_all
+	auto set = comm::world.post( irecv_from(other, msg(in_a)),
+								 irecv_from(other, in_b),
+								 isend_to(other, msg(a)),
+								 isend_to(other, b) );
+	EXPECT_EQ( static_cast<size_t>(4), set.size() );
+	set.wait_all();
+
+	for(double cur : in_a) { EXPECT_EQ( other + 0.5, cur ); }
+	EXPECT_EQ( other * 10, in_b );
+
+	auto s = set.status_of(0);
+	EXPECT_EQ( other, s.source().rank() );
+	EXPECT_EQ( 8, s.count() );
+}
+
+TEST(RequestSet, WaitAny) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	int a = -1, b = -1;
+
+	request_set set;
+	size_t ra = set.add( comm::world(other) > msg(a, 1) );
+	size_t rb = set.add( comm::world(other) > msg(b, 2) );
+
+	comm::world(other) << msg<const int>(10, 1);
+	comm::world(other) << msg<const int>(20, 2);
+
+	size_t first = set.wait_any();
+	EXPECT_TRUE( first == ra || first == rb );
+	set.wait_all();
+
+	EXPECT_EQ(10, a);
+	EXPECT_EQ(20, b);
+
+	auto s = set.status_of(ra);
+	EXPECT_EQ( other, s.source().rank() );
+	EXPECT_EQ( 1, s.tag() );
+}
+
+TEST(RequestSet, WaitSome) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> in(8, -1);
+
+	request_set set;
+	for(size_t i=0; i<in.size(); ++i) {
+		set.add( comm::world(other) > msg(in[i], static_cast<int>(i)) );
+	}
+
+	std::vector<int> out(8);
+	for(size_t i=0; i<out.size(); ++i) {
+		out[i] = static_cast<int>(100+i);
+		comm::world(other) << msg(out[i], static_cast<int>(i));
+	}
+
+	size_t completed = 0;
+	while( completed < in.size() ) {
+		completed += set.wait_some().size();
+	}
+
+	for(size_t i=0; i<in.size(); ++i) {
+		EXPECT_EQ( static_cast<int>(100+i), in[i] );
+	}
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(SharedWindow, NodeComm) {
+	// both test ranks run on the same node
+	EXPECT_EQ( 2, comm::node().size() );
+}
+
+TEST(SharedWindow, PutGet) {
+	int me = comm::node().rank();
+	int other = me == 0 ? 1 : 0;
+
+	shared_window<int> win(8);
+
+	if ( me == 0 ) {
+		std::vector<int> v{ 1, 2, 3, 4 };
+		win.put( other, v );
+		win.put( other, 99, 7 );	// single element at offset 7
+	}
+	win.sync();
+
+	if ( me == 1 ) {
+		std::vector<int> in(4, -1);
+		win.get( me, in );
+		for(size_t i=0; i<in.size(); ++i) {
+			EXPECT_EQ( static_cast<int>(i) + 1, in[i] );
+		}
+		EXPECT_EQ( 99, win.local()[7] );
+	}
+	win.sync();
+}
+
+TEST(SharedWindow, DirectStore) {
+	int me = comm::node().rank();
+	int other = me == 0 ? 1 : 0;
+
+	shared_window<double> win(2);
+	win.local()[0] = 0.0;
+	win.local()[1] = 0.0;
+	win.sync();
+
+	// plain stores into the peer's segment, no MPI call involved
+	win[other][0] = me + 0.5;
+	win.sync();
+
+	EXPECT_EQ( other + 0.5, win.local()[0] );
+	win.sync();
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
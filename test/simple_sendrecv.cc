@@ -116,6 +116,24 @@ TEST(SendRecv, Array) {
 // }
 
 
+TEST(SendRecv, ProbeRecv) {
+	if(comm::world.rank() == 0) {
+		// size only known by the sender
+		std::vector<int> data(7);
+		for(size_t i=0; i<data.size(); ++i) { data[i] = static_cast<int>(i*i); }
+		comm::world(1) << data;
+	} else if (comm::world.rank() == 1) {
+		std::vector<int> vec;
+		auto s = comm::world(0).probe_recv(vec);
+		EXPECT_EQ( static_cast<size_t>(7), vec.size() );
+		EXPECT_EQ( 7, s.count() );
+		EXPECT_EQ( 0, s.source().rank() );
+		for(size_t i=0; i<vec.size(); ++i) {
+			EXPECT_EQ( static_cast<int>(i*i), vec[i] );
+		}
+	}
+}
+
 TEST(Performance, MpiScalar) {
 	
 	int rank;
@@ -152,6 +170,33 @@ TEST(Performance, MpiScalar) {
 
 }
 
+TEST(SendRecv, StaticSize) {
+	// the extent of these messages is part of the type: the count handed
+	// to MPI is a compile-time constant (see mpi_static_size)
+	static_assert( mpi_static_size<int>::known &&
+				   mpi_static_size<int>::value == 1,
+				   "scalar extent must be statically known" );
+	static_assert( mpi_static_size<std::array<double,8>>::known &&
+				   mpi_static_size<std::array<double,8>>::value == 8,
+				   "array extent must be statically known" );
+	static_assert( !mpi_static_size<std::vector<int>>::known,
+				   "vector extent is only known at run time" );
+
+	if (comm::world.rank() == 0) {
+		std::array<double, 8> out;
+		for(size_t i=0; i<out.size(); ++i) { out[i] = i * 0.5; }
+		comm::world(1) << msg(out);
+	} else if (comm::world.rank() == 1) {
+		std::array<double, 8> in;
+		in.fill(-1.0);
+		auto s = comm::world(0) >> msg(in);
+		EXPECT_EQ( 8, s.count() );
+		for(size_t i=0; i<in.size(); ++i) {
+			EXPECT_EQ( i * 0.5, in[i] );
+		}
+	}
+}
+
 TEST(Performance, MppScalar) {
 
 	using mpi::comm;
@@ -0,0 +1,65 @@
+#define MPP_INSTRUMENT
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <sstream>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Stats, Counters) {
+	stats::reset();
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> buf(16);
+	if ( comm::world.rank() == 0 ) {
+		for(int i=0; i<5; ++i) { comm::world(other).send( msg(buf) ); }
+	} else {
+		for(int i=0; i<5; ++i) { comm::world(other) >> buf; }
+	}
+
+	auto snap = stats::snapshot();
+	ASSERT_LT( static_cast<size_t>(other), snap.size() );
+
+	const stats::counters& c = snap[other];
+	EXPECT_EQ( 5u, c.messages );
+	EXPECT_EQ( 5u * 16 * sizeof(int), c.bytes );
+	EXPECT_LE( 0.0, c.total_time );
+	EXPECT_LE( c.max_latency, c.total_time );
+}
+
+TEST(Stats, Trace) {
+	stats::reset();
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	int v = 42;
+	if ( comm::world.rank() == 0 ) {
+		comm::world(other).send( msg(v, 9) );
+		auto r = comm::world(other).isend( msg(v, 9) );
+		r.get();
+	} else {
+		comm::world(other) >> msg(v, 9);
+		comm::world(other) >> msg(v, 9);
+	}
+
+	std::ostringstream os;
+	stats::dump_trace(os);
+	std::string trace = os.str();
+
+	// one line per event, each carrying the peer, the tag and the bytes
+	EXPECT_EQ( 2, std::count(trace.begin(), trace.end(), '\n') );
+	EXPECT_NE( std::string::npos, trace.find(" 9 4\n") );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
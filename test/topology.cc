@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+#include <algorithm>
+
+using namespace mpi;
+
+TEST(Comm, Dup) {
+	comm clone = comm::world.dup();
+	EXPECT_EQ( comm::world.rank(), clone.rank() );
+	EXPECT_EQ( comm::world.size(), clone.size() );
+
+	// a message sent over the duplicate cannot be matched by a receive
+	// posted on world: same tag, disjoint tag space
+	int other = comm::world.rank() == 0 ? 1 : 0;
+	int out = comm::world.rank(), in = -1;
+	clone(other) << out;
+	clone(other) >> in;
+	EXPECT_EQ( other, in );
+}
+
+TEST(Comm, Split) {
+	// every rank in its own sub-communicator
+	comm sub = comm::world.split( comm::world.rank() );
+	EXPECT_EQ( 0, sub.rank() );
+	EXPECT_EQ( 1, sub.size() );
+}
+
+TEST(Comm, Cartesian) {
+	// 1D periodic ring over all ranks
+	std::vector<int> dims    ( 1, comm::world.size() );
+	std::vector<int> periods ( 1, 1 );
+
+	cartesian_comm ring( comm::world, dims, periods, false );
+
+	EXPECT_EQ( static_cast<size_t>(1), ring.ndims() );
+	EXPECT_EQ( ring.rank(), ring.coords()[0] );
+
+	// shift a token around the ring: send to plus, receive from minus
+	int token = ring.rank();
+	int recv = -1;
+
+	auto req = ring.minus(0) > recv;
+	ring.plus(0) << token;
+	req.get();
+
+	int expected = (ring.rank() + ring.size() - 1) % ring.size();
+	EXPECT_EQ( expected, recv );
+}
+
+TEST(Comm, NeighborExchange) {
+	// 1D periodic ring: each rank ships 3 elements to each of its two
+	// neighbors in a single neighborhood collective per step
+	std::vector<int> dims    ( 1, comm::world.size() );
+	std::vector<int> periods ( 1, 1 );
+
+	cartesian_comm ring( comm::world, dims, periods, false );
+	ring.set_halo( std::vector<int>(2, 3), std::vector<int>(2, 3) );
+
+	EXPECT_EQ( 6, ring.halo_send_size() );
+	EXPECT_EQ( 6, ring.halo_recv_size() );
+
+	std::vector<int> out( ring.halo_send_size() );
+	std::vector<int> in ( ring.halo_recv_size(), -1 );
+
+	for(int step=0; step<3; ++step) {
+		// block 0 goes to minus(0), block 1 to plus(0)
+		for(int i=0; i<3; ++i) {
+			out[i]   = ring.rank()*100 + step*10 + i;		// to minus
+			out[3+i] = ring.rank()*100 + step*10 + 5 + i;	// to plus
+		}
+
+		ring.neighbor_exchange( out, in );
+
+		int left  = (ring.rank() + ring.size() - 1) % ring.size();
+		int right = (ring.rank() + 1) % ring.size();
+
+		// block 0 came from minus (its "to plus" block), block 1 from plus
+		for(int i=0; i<3; ++i) {
+			EXPECT_EQ( left*100  + step*10 + 5 + i, in[i] );
+			EXPECT_EQ( right*100 + step*10 + i,     in[3+i] );
+		}
+	}
+}
+
+TEST(Comm, INeighborExchange) {
+	std::vector<int> dims    ( 1, comm::world.size() );
+	std::vector<int> periods ( 1, 1 );
+
+	cartesian_comm ring( comm::world, dims, periods, false );
+	ring.set_halo( std::vector<int>(2, 1), std::vector<int>(2, 1) );
+
+	std::vector<double> out(2), in(2, -1.0);
+	out[0] = ring.rank() + 0.25;	// to minus
+	out[1] = ring.rank() + 0.75;	// to plus
+
+	auto req = ring.ineighbor_exchange( out, in );
+	req.get();
+
+	int left  = (ring.rank() + ring.size() - 1) % ring.size();
+	int right = (ring.rank() + 1) % ring.size();
+
+	// on a 2-rank ring both neighbors are the same peer, and the pairing
+	// of the two same-pair blocks is implementation-defined: compare the
+	// received values as a set
+	std::vector<double> expected;
+	expected.push_back( left + 0.75 );
+	expected.push_back( right + 0.25 );
+	std::sort( expected.begin(), expected.end() );
+	std::sort( in.begin(), in.end() );
+	EXPECT_EQ( expected[0], in[0] );
+	EXPECT_EQ( expected[1], in[1] );
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}
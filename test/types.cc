@@ -5,6 +5,14 @@
 
 using namespace mpi;
 
+struct particle {
+	double 	pos[3];
+	double 	vel[3];
+	int 	id;
+};
+
+MPP_REGISTER_TYPE(particle, &particle::pos, &particle::vel, &particle::id)
+
 TEST(Type, Char) {
 	if(comm::world.rank() == 0) {
 		comm::world(1) << 'a';
@@ -46,6 +54,60 @@ TEST(Type, LongDouble) {
 	}
 }
 
+TEST(Type, String) {
+	if(comm::world.rank() == 0) {
+		std::string out = "hello mpp";
+		comm::world(1) << out;
+	} else if (comm::world.rank() == 1) {
+		// fixed-size receive straight into the string's storage
+		std::string val(9, ' ');
+		comm::world(0) >> val;
+		EXPECT_EQ("hello mpp", val);
+	}
+}
+
+TEST(Type, StringProbeRecv) {
+	if(comm::world.rank() == 0) {
+		std::string out = "sized by the probe";
+		comm::world(1) << out;
+	} else if (comm::world.rank() == 1) {
+		std::string val;
+		auto s = comm::world(0).probe_recv(val);
+		EXPECT_EQ(18, s.count());
+		EXPECT_EQ("sized by the probe", val);
+	}
+}
+
+TEST(Type, DeviceSpan) {
+	// host memory stands in for a device allocation here: the traits only
+	// forward the raw pointer, which is the property under test
+	double storage[4] = { 0.0, 0.0, 0.0, 0.0 };
+	device_span<double> span( storage, 4 );
+
+	if(comm::world.rank() == 0) {
+		for(int i=0; i<4; ++i) { storage[i] = i * 1.5; }
+		comm::world(1) << span;
+	} else if (comm::world.rank() == 1) {
+		auto s = comm::world(0) >> span;
+		EXPECT_EQ( 4, s.count() );
+		EXPECT_EQ( 4.5, storage[3] );
+	}
+}
+
+#if __cplusplus >= 201703L
+TEST(Type, StringView) {
+	if(comm::world.rank() == 0) {
+		std::string storage = "through a view";
+		std::string_view out = storage;
+		comm::world(1) << out;
+	} else if (comm::world.rank() == 1) {
+		std::string val;
+		comm::world(0).probe_recv(val);
+		EXPECT_EQ("through a view", val);
+	}
+}
+#endif
+
 TEST(Type, Complex) {
 	if(comm::world.rank() == 0) {
 		comm::world(1) << std::complex<float>(10.3, 2.4);
@@ -57,6 +119,41 @@ TEST(Type, Complex) {
 	}
 }
 
+TEST(Type, RegisteredStruct) {
+	if(comm::world.rank() == 0) {
+		particle p;
+		for(int i=0; i<3; ++i) { p.pos[i] = i*1.5; p.vel[i] = -i*0.5; }
+		p.id = 7;
+		comm::world(1) << p;
+	} else if (comm::world.rank() == 1) {
+		particle p;
+		comm::world(0) >> p;
+		for(int i=0; i<3; ++i) {
+			EXPECT_EQ( i*1.5, p.pos[i] );
+			EXPECT_EQ( -i*0.5, p.vel[i] );
+		}
+		EXPECT_EQ( 7, p.id );
+	}
+}
+
+TEST(Type, RegisteredStructVector) {
+	if(comm::world.rank() == 0) {
+		std::vector<particle> parts(10);
+		for(size_t i=0; i<parts.size(); ++i) {
+			parts[i].pos[0] = static_cast<double>(i);
+			parts[i].id = static_cast<int>(i);
+		}
+		comm::world(1) << parts;
+	} else if (comm::world.rank() == 1) {
+		std::vector<particle> parts(10);
+		comm::world(0) >> parts;
+		for(size_t i=0; i<parts.size(); ++i) {
+			EXPECT_EQ( static_cast<double>(i), parts[i].pos[0] );
+			EXPECT_EQ( static_cast<int>(i), parts[i].id );
+		}
+	}
+}
+
 int main(int argc, char** argv) {
 	MPI_Init(&argc, &argv);
 	// Disables elapsed time by default.
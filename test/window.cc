@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <mpp.h>
+#include <vector>
+
+using namespace mpi;
+
+TEST(Window, Put) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> local(4, -1);
+	window<std::vector<int>> win(comm::world, local);
+	win.lock_all();
+
+	if ( comm::world.rank() == 0 ) {
+		std::vector<int> v{ 10, 11, 12, 13 };
+		auto r = win(other).put( msg(v) );
+		r.get();				// local completion
+		win.flush(other);		// remote completion
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	win.sync();
+
+	if ( comm::world.rank() == 1 ) {
+		for(size_t i=0; i<local.size(); ++i) {
+			EXPECT_EQ( 10 + static_cast<int>(i), local[i] );
+		}
+	}
+
+	win.unlock_all();
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(Window, GetWithOffset) {
+	int other = comm::world.rank() == 0 ? 1 : 0;
+
+	std::vector<int> local(8);
+	for(size_t i=0; i<local.size(); ++i) {
+		local[i] = comm::world.rank()*100 + static_cast<int>(i);
+	}
+
+	window<std::vector<int>> win(comm::world, local);
+	win.lock_all();
+
+	// read the upper half of the other rank's buffer
+	std::vector<int> in(4, -1);
+	auto r = win(other).get( msg(in), 4 );
+	r.get();
+
+	for(size_t i=0; i<in.size(); ++i) {
+		EXPECT_EQ( other*100 + 4 + static_cast<int>(i), in[i] );
+	}
+
+	win.unlock_all();
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(Window, Accumulate) {
+	std::vector<int> local(2, 0);
+	window<std::vector<int>> win(comm::world, local);
+	win.lock_all();
+
+	// every rank adds its contribution into rank 0's buffer
+	std::vector<int> v{ 5, 7 };
+	auto r = win(0).accumulate( msg(v) );
+	r.get();
+	win.flush(0);
+
+	MPI_Barrier(MPI_COMM_WORLD);
+	win.sync();
+
+	if ( comm::world.rank() == 0 ) {
+		EXPECT_EQ( 5 * comm::world.size(), local[0] );
+		EXPECT_EQ( 7 * comm::world.size(), local[1] );
+	}
+
+	win.unlock_all();
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+int main(int argc, char** argv) {
+	MPI_Init(&argc, &argv);
+	// Disables elapsed time by default.
+	::testing::GTEST_FLAG(print_time) = true;
+
+	// This allows the user to override the flag on the command line.
+	::testing::InitGoogleTest(&argc, argv);
+
+	size_t errcode = RUN_ALL_TESTS();
+	MPI_Finalize();
+	return static_cast<int>(errcode);
+}